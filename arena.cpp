@@ -0,0 +1,120 @@
+#include "arena.h"
+#include <cstdlib>
+#include <cstdio>
+#include <cstdarg>
+#include <new>
+
+MemoryArena frameArena;
+MemoryArena matchArena;
+
+static const size_t MIN_OVERFLOW_BLOCK = 16 * 1024;
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+MemoryArena::~MemoryArena() {
+    releaseOverflow();
+    std::free(mainBlock);
+}
+
+void MemoryArena::init(size_t capacity) {
+    if (capacity <= mainCapacity) return;
+    // Only safe while nothing is allocated from the main block
+    if (mainOffset == 0) {
+        std::free(mainBlock);
+        mainBlock = static_cast<unsigned char*>(std::malloc(capacity));
+        if (!mainBlock) throw std::bad_alloc();
+        mainCapacity = capacity;
+    }
+}
+
+void* MemoryArena::allocate(size_t size, size_t alignment) {
+    if (size == 0) size = 1;
+
+    // malloc'd blocks are max_align_t aligned, so aligning offsets is enough
+    size_t offset = alignUp(mainOffset, alignment);
+    if (!overflow && offset + size <= mainCapacity) {
+        mainOffset = offset + size;
+        usedBytes += size;
+        if (usedBytes > highWaterBytes) highWaterBytes = usedBytes;
+        return mainBlock + offset;
+    }
+    return allocateOverflow(size, alignment);
+}
+
+void* MemoryArena::allocateOverflow(size_t size, size_t alignment) {
+    const size_t header = alignUp(sizeof(OverflowBlock), alignof(std::max_align_t));
+
+    if (overflow) {
+        size_t offset = alignUp(overflow->offset, alignment);
+        if (offset + size <= overflow->capacity) {
+            overflow->offset = offset + size;
+            usedBytes += size;
+            if (usedBytes > highWaterBytes) highWaterBytes = usedBytes;
+            return reinterpret_cast<unsigned char*>(overflow) + header + offset;
+        }
+    }
+
+    // Grow geometrically so a burst of allocations takes few blocks
+    size_t capacity = alignUp(size, alignment) + alignment;
+    size_t minimum = usedBytes > MIN_OVERFLOW_BLOCK ? usedBytes : MIN_OVERFLOW_BLOCK;
+    if (capacity < minimum) capacity = minimum;
+
+    OverflowBlock* block = static_cast<OverflowBlock*>(std::malloc(header + capacity));
+    if (!block) throw std::bad_alloc();
+    block->next = overflow;
+    block->capacity = capacity;
+    block->offset = 0;
+    overflow = block;
+    overflowBlockCount++;
+
+    size_t offset = alignUp(0, alignment);
+    block->offset = offset + size;
+    usedBytes += size;
+    if (usedBytes > highWaterBytes) highWaterBytes = usedBytes;
+    return reinterpret_cast<unsigned char*>(block) + header + offset;
+}
+
+void MemoryArena::releaseOverflow() {
+    while (overflow) {
+        OverflowBlock* next = overflow->next;
+        std::free(overflow);
+        overflow = next;
+    }
+    overflowBlockCount = 0;
+}
+
+void MemoryArena::reset() {
+    // Overflowing means the main block is too small; replace it with one that fits the peak
+    // (plus alignment slack) so the same load next time stays in one block
+    if (overflow) {
+        releaseOverflow();
+        size_t capacity = highWaterBytes + highWaterBytes / 4;
+        std::free(mainBlock);
+        mainBlock = static_cast<unsigned char*>(std::malloc(capacity));
+        if (!mainBlock) throw std::bad_alloc();
+        mainCapacity = capacity;
+    }
+    mainOffset = 0;
+    usedBytes = 0;
+}
+
+const char* frameFormat(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list measureArgs;
+    va_copy(measureArgs, args);
+    int length = std::vsnprintf(nullptr, 0, format, measureArgs);
+    va_end(measureArgs);
+
+    if (length < 0) {
+        va_end(args);
+        return "";
+    }
+
+    char* text = frameArena.allocate<char>(static_cast<size_t>(length) + 1);
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, format, args);
+    va_end(args);
+    return text;
+}
@@ -0,0 +1,88 @@
+#pragma once
+// Linear (bump) allocators for data with a known lifetime.
+// An arena hands out memory by advancing an offset and frees everything at once on reset().
+// When the current block runs out, overflow blocks are taken from the heap; the next reset()
+// folds them into one main block sized to the high-water mark, so once the arena has seen its
+// busiest frame (or match) it stops calling the heap altogether.
+//
+// Two arenas are provided: frameArena is reset once per rendered frame, matchArena whenever a
+// new match starts. Anything allocated from them must be dropped before that reset.
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+class MemoryArena {
+public:
+    MemoryArena() = default;
+    ~MemoryArena();
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    // Reserve the main block up front (optional; the arena grows on demand)
+    void init(size_t capacity);
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    template <typename T> T* allocate(size_t count) { return static_cast<T*>(allocate(count * sizeof(T), alignof(T))); }
+
+    // Free everything allocated since the last reset
+    void reset();
+
+    size_t used() const { return usedBytes; }
+    size_t capacity() const { return mainCapacity; }
+    size_t highWater() const { return highWaterBytes; }
+    uint32_t overflowCount() const { return overflowBlockCount; } // Heap blocks taken since the last reset
+
+private:
+    void* allocateOverflow(size_t size, size_t alignment);
+    void releaseOverflow();
+
+    unsigned char* mainBlock = nullptr;
+    size_t mainCapacity = 0;
+    size_t mainOffset = 0;
+
+    // Singly linked list of heap blocks taken after the main block filled up
+    struct OverflowBlock {
+        OverflowBlock* next;
+        size_t capacity;
+        size_t offset;
+    };
+    OverflowBlock* overflow = nullptr;
+    uint32_t overflowBlockCount = 0;
+
+    size_t usedBytes = 0;
+    size_t highWaterBytes = 0;
+};
+
+extern MemoryArena frameArena;
+extern MemoryArena matchArena;
+
+// Allocator adaptor so std containers can live in an arena. Deallocation is a no-op; the
+// memory comes back when the arena resets.
+template <typename T, MemoryArena& Arena>
+struct ArenaAllocator {
+    typedef T value_type;
+
+    template <typename U> struct rebind { typedef ArenaAllocator<U, Arena> other; };
+
+    ArenaAllocator() = default;
+    template <typename U> ArenaAllocator(const ArenaAllocator<U, Arena>&) {}
+
+    T* allocate(size_t count) { return Arena.template allocate<T>(count); }
+    void deallocate(T*, size_t) {}
+};
+
+template <typename T, typename U, MemoryArena& Arena>
+bool operator==(const ArenaAllocator<T, Arena>&, const ArenaAllocator<U, Arena>&) { return true; }
+template <typename T, typename U, MemoryArena& Arena>
+bool operator!=(const ArenaAllocator<T, Arena>&, const ArenaAllocator<U, Arena>&) { return false; }
+
+template <typename T> using FrameAllocator = ArenaAllocator<T, frameArena>;
+template <typename T> using MatchAllocator = ArenaAllocator<T, matchArena>;
+
+template <typename T> using FrameVector = std::vector<T, FrameAllocator<T>>;
+template <typename T> using MatchVector = std::vector<T, MatchAllocator<T>>;
+typedef std::basic_string<char, std::char_traits<char>, FrameAllocator<char>> FrameString;
+
+// printf into the frame arena; the result is valid until the end of the frame
+const char* frameFormat(const char* format, ...);
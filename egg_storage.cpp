@@ -0,0 +1,167 @@
+#include "egg_storage.h"
+
+EggHandle EggStorage::add(const glm::vec3& position, float eggRadius, const glm::vec3& eggColor, float eggSpawnTime,
+    float lifespan, bool poison, float eggChaseSpeed, float eggChaseStartTime) {
+    const uint32_t dense = static_cast<uint32_t>(flags.size());
+
+    // Reuse a free slot if there is one; generations start at 1 so a default handle is never valid
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        slot = static_cast<uint32_t>(slotToDense.size());
+        slotToDense.push_back(0);
+        slotGeneration.push_back(1);
+    }
+    slotToDense[slot] = dense;
+    denseToSlot.push_back(slot);
+
+    positionX.push_back(position.x);
+    positionY.push_back(position.y);
+    positionZ.push_back(position.z);
+    lifeTimer.push_back(lifespan);
+    scale.push_back(0.0f); // Start at scale 0 for spawn animation
+    pulseFactor.push_back(0.0f);
+    velocityX.push_back(0.0f);
+    velocityZ.push_back(0.0f);
+    flags.push_back(static_cast<unsigned char>(EGG_SPAWNING | (poison ? EGG_POISON : 0)));
+
+    previousX.push_back(position.x);
+    previousY.push_back(position.y);
+    previousZ.push_back(position.z);
+
+    radius.push_back(eggRadius);
+    color.push_back(eggColor);
+    spawnTime.push_back(eggSpawnTime);
+    chaseSpeed.push_back(eggChaseSpeed);
+    chaseStartTime.push_back(eggChaseStartTime);
+
+    if (poison) livePoison++;
+    else liveRegular++;
+
+    EggHandle handle;
+    handle.slot = slot;
+    handle.generation = slotGeneration[slot];
+    return handle;
+}
+
+// Move the last element of one array into index i and drop the tail
+template <typename T>
+static void swapRemove(std::vector<T>& values, size_t i) {
+    values[i] = values.back();
+    values.pop_back();
+}
+
+void EggStorage::remove(size_t i) {
+    if (flags[i] & EGG_POISON) livePoison--;
+    else liveRegular--;
+
+    // Retire the slot so handles to this egg go stale
+    const uint32_t slot = denseToSlot[i];
+    slotGeneration[slot]++;
+    freeSlots.push_back(slot);
+
+    // The last egg takes over index i
+    const uint32_t movedSlot = denseToSlot.back();
+    slotToDense[movedSlot] = static_cast<uint32_t>(i);
+    swapRemove(denseToSlot, i);
+
+    swapRemove(positionX, i);
+    swapRemove(positionY, i);
+    swapRemove(positionZ, i);
+    swapRemove(lifeTimer, i);
+    swapRemove(scale, i);
+    swapRemove(pulseFactor, i);
+    swapRemove(velocityX, i);
+    swapRemove(velocityZ, i);
+    swapRemove(flags, i);
+    swapRemove(previousX, i);
+    swapRemove(previousY, i);
+    swapRemove(previousZ, i);
+    swapRemove(radius, i);
+    swapRemove(color, i);
+    swapRemove(spawnTime, i);
+    swapRemove(chaseSpeed, i);
+    swapRemove(chaseStartTime, i);
+}
+
+bool EggStorage::remove(EggHandle handle) {
+    if (!isValid(handle)) return false;
+    remove(slotToDense[handle.slot]);
+    return true;
+}
+
+EggHandle EggStorage::handleAt(size_t i) const {
+    EggHandle handle;
+    handle.slot = denseToSlot[i];
+    handle.generation = slotGeneration[handle.slot];
+    return handle;
+}
+
+bool EggStorage::isValid(EggHandle handle) const {
+    return handle.slot < slotGeneration.size() && slotGeneration[handle.slot] == handle.generation;
+}
+
+size_t EggStorage::indexOf(EggHandle handle) const {
+    return slotToDense[handle.slot];
+}
+
+void EggStorage::savePositions() {
+    previousX = positionX;
+    previousY = positionY;
+    previousZ = positionZ;
+}
+
+void EggStorage::clear() {
+    for (uint32_t slot : denseToSlot) {
+        slotGeneration[slot]++;
+        freeSlots.push_back(slot);
+    }
+    denseToSlot.clear();
+    liveRegular = 0;
+    livePoison = 0;
+
+    positionX.clear();
+    positionY.clear();
+    positionZ.clear();
+    lifeTimer.clear();
+    scale.clear();
+    pulseFactor.clear();
+    velocityX.clear();
+    velocityZ.clear();
+    flags.clear();
+    previousX.clear();
+    previousY.clear();
+    previousZ.clear();
+    radius.clear();
+    color.clear();
+    spawnTime.clear();
+    chaseSpeed.clear();
+    chaseStartTime.clear();
+}
+
+void EggStorage::reserve(size_t count) {
+    positionX.reserve(count);
+    positionY.reserve(count);
+    positionZ.reserve(count);
+    lifeTimer.reserve(count);
+    scale.reserve(count);
+    pulseFactor.reserve(count);
+    velocityX.reserve(count);
+    velocityZ.reserve(count);
+    flags.reserve(count);
+    previousX.reserve(count);
+    previousY.reserve(count);
+    previousZ.reserve(count);
+    radius.reserve(count);
+    color.reserve(count);
+    spawnTime.reserve(count);
+    chaseSpeed.reserve(count);
+    chaseStartTime.reserve(count);
+    denseToSlot.reserve(count);
+    slotToDense.reserve(count);
+    slotGeneration.reserve(count);
+    freeSlots.reserve(count);
+}
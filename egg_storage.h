@@ -0,0 +1,97 @@
+#pragma once
+// Struct-of-arrays egg container.
+// Fields touched every tick live in their own contiguous arrays so the update and draw loops
+// only stream what they use; rarely-read fields are kept apart from them.
+//
+// The arrays are dense: every stored egg is live, and removing one moves the last egg into
+// its place. Eggs are referred to across ticks through generation-checked handles, which
+// stay valid while the egg moves around and go stale once it is removed.
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Egg state bits
+enum EggFlags {
+    EGG_SPAWNING = 1 << 0,
+    EGG_DESPAWNING = 1 << 1,
+    EGG_POISON = 1 << 2,   // Distinguishes poison eggs from collectible ones
+    EGG_CHASING = 1 << 3
+};
+
+// Stable reference to an egg. A default-constructed handle never refers to an egg.
+struct EggHandle {
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+};
+
+struct EggStorage {
+    // Hot: read or written every tick
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> positionZ;
+    std::vector<float> lifeTimer;
+    std::vector<float> scale;
+    std::vector<float> pulseFactor;
+    std::vector<float> velocityX; // Chasing only moves on the horizontal plane
+    std::vector<float> velocityZ;
+    std::vector<unsigned char> flags;
+
+    // Position at the start of the current simulation tick (for render interpolation)
+    std::vector<float> previousX;
+    std::vector<float> previousY;
+    std::vector<float> previousZ;
+
+    // Cold: read on spawn, collection and draw
+    std::vector<float> radius;
+    std::vector<glm::vec3> color;
+    std::vector<float> spawnTime;
+    std::vector<float> chaseSpeed;
+    std::vector<float> chaseStartTime;
+
+    size_t size() const { return flags.size(); }
+    bool empty() const { return flags.empty(); }
+
+    bool isPoison(size_t i) const { return (flags[i] & EGG_POISON) != 0; }
+    bool hasFlag(size_t i, unsigned char flag) const { return (flags[i] & flag) != 0; }
+    void setFlag(size_t i, unsigned char flag) { flags[i] |= flag; }
+    void clearFlag(size_t i, unsigned char flag) { flags[i] &= static_cast<unsigned char>(~flag); }
+
+    glm::vec3 position(size_t i) const { return glm::vec3(positionX[i], positionY[i], positionZ[i]); }
+    glm::vec3 previousPosition(size_t i) const { return glm::vec3(previousX[i], previousY[i], previousZ[i]); }
+
+    // Live egg counts, kept up to date by add/remove
+    int regularCount() const { return liveRegular; }
+    int poisonCount() const { return livePoison; }
+
+    // Append a new egg (starting at scale 0 for its spawn animation)
+    EggHandle add(const glm::vec3& position, float radius, const glm::vec3& color, float spawnTime,
+        float lifespan, bool poison, float chaseSpeed, float chaseStartTime);
+
+    // Remove the egg at a dense index in O(1). The last egg is moved into index i, so a
+    // forward loop must look at index i again instead of advancing.
+    void remove(size_t i);
+    bool remove(EggHandle handle);
+
+    // Handle <-> dense index
+    EggHandle handleAt(size_t i) const;
+    bool isValid(EggHandle handle) const;
+    size_t indexOf(EggHandle handle) const; // Handle must be valid
+
+    // Copy current positions into the previous-tick arrays
+    void savePositions();
+
+    // Remove every egg; outstanding handles become stale
+    void clear();
+    void reserve(size_t count);
+
+private:
+    // Sparse side: slot -> dense index, plus the generation that tells reused slots apart
+    std::vector<uint32_t> slotToDense;
+    std::vector<uint32_t> slotGeneration;
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> denseToSlot;
+
+    int liveRegular = 0;
+    int livePoison = 0;
+};
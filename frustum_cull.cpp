@@ -0,0 +1,98 @@
+#include "frustum_cull.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRUSTUM_CULL_SSE2 1
+#include <emmintrin.h>
+#else
+#define FRUSTUM_CULL_SSE2 0
+#endif
+
+ViewFrustum makeViewFrustum(const glm::mat4& viewProjection, const glm::vec3& eye, float minPixels, float pixelsPerUnit) {
+    // Each clip plane is the last matrix row plus or minus one of the others (Gribb & Hartmann)
+    const glm::mat4& m = viewProjection;
+    glm::vec4 row[4];
+    for (int i = 0; i < 4; i++) row[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+
+    ViewFrustum frustum;
+    frustum.planes[0] = row[3] + row[0]; // Left
+    frustum.planes[1] = row[3] - row[0]; // Right
+    frustum.planes[2] = row[3] + row[1]; // Bottom
+    frustum.planes[3] = row[3] - row[1]; // Top
+    frustum.planes[4] = row[3] + row[2]; // Near
+    frustum.planes[5] = row[3] - row[2]; // Far
+    for (glm::vec4& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+
+    frustum.eye = eye;
+    frustum.minRadiusRatio = pixelsPerUnit > 0.0f ? minPixels / pixelsPerUnit : 0.0f;
+    return frustum;
+}
+
+static bool sphereVisible(const ViewFrustum& frustum, float x, float y, float z, float radius) {
+    for (const glm::vec4& plane : frustum.planes) {
+        // Same grouping as the vector path, so both agree on spheres touching a plane
+        if ((plane.x * x + plane.y * y) + (plane.z * z + plane.w) + radius < 0.0f) return false;
+    }
+
+    // Compare squares so no square root is needed: radius / distance >= ratio
+    const float dx = x - frustum.eye.x, dy = y - frustum.eye.y, dz = z - frustum.eye.z;
+    const float ratioSquared = frustum.minRadiusRatio * frustum.minRadiusRatio;
+    return radius * radius >= ratioSquared * (dx * dx + dy * dy + dz * dz);
+}
+
+bool sphereVisible(const ViewFrustum& frustum, const glm::vec3& center, float radius) {
+    return sphereVisible(frustum, center.x, center.y, center.z, radius);
+}
+
+size_t cullSpheres(const ViewFrustum& frustum, const float* x, const float* y, const float* z, const float* radius,
+    size_t count, uint32_t* visible) {
+    size_t visibleCount = 0;
+    size_t i = 0;
+
+#if FRUSTUM_CULL_SSE2
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (int p = 0; p < 6; p++) {
+        planeX[p] = _mm_set1_ps(frustum.planes[p].x);
+        planeY[p] = _mm_set1_ps(frustum.planes[p].y);
+        planeZ[p] = _mm_set1_ps(frustum.planes[p].z);
+        planeW[p] = _mm_set1_ps(frustum.planes[p].w);
+    }
+    const __m128 eyeX = _mm_set1_ps(frustum.eye.x);
+    const __m128 eyeY = _mm_set1_ps(frustum.eye.y);
+    const __m128 eyeZ = _mm_set1_ps(frustum.eye.z);
+    const __m128 ratioSquared = _mm_set1_ps(frustum.minRadiusRatio * frustum.minRadiusRatio);
+    const __m128 zero = _mm_setzero_ps();
+    const size_t vectorCount = count & ~static_cast<size_t>(3);
+
+    // Four spheres at a time against all six planes, then pack the survivors' indices
+    for (; i < vectorCount; i += 4) {
+        const __m128 cx = _mm_loadu_ps(x + i);
+        const __m128 cy = _mm_loadu_ps(y + i);
+        const __m128 cz = _mm_loadu_ps(z + i);
+        const __m128 r = _mm_loadu_ps(radius + i);
+
+        const __m128 dx = _mm_sub_ps(cx, eyeX);
+        const __m128 dy = _mm_sub_ps(cy, eyeY);
+        const __m128 dz = _mm_sub_ps(cz, eyeZ);
+        const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        __m128 inside = _mm_cmpge_ps(_mm_mul_ps(r, r), _mm_mul_ps(ratioSquared, distanceSquared));
+
+        for (int p = 0; p < 6; p++) {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy)),
+                _mm_add_ps(_mm_mul_ps(planeZ[p], cz), planeW[p]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, r), zero));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; lane++) {
+            if (mask & (1 << lane)) visible[visibleCount++] = static_cast<uint32_t>(i + lane);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (sphereVisible(frustum, x[i], y[i], z[i], radius[i])) visible[visibleCount++] = static_cast<uint32_t>(i);
+    }
+    return visibleCount;
+}
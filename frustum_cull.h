@@ -0,0 +1,26 @@
+#pragma once
+// View-frustum culling for bounding spheres stored as one array per component.
+// The planes come straight out of a projection * view matrix, so the far plane doubles as the
+// draw distance. Spheres too small on screen to cover a pixel are dropped as well, which
+// culls small objects sooner than large ones as they move away.
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+struct ViewFrustum {
+    glm::vec4 planes[6];      // Normal (pointing inside) and offset, normalized so distances are in world units
+    glm::vec3 eye;
+    float minRadiusRatio = 0; // Radius / distance below which a sphere is too small to draw; 0 keeps all
+};
+
+// minPixels is the smallest projected radius worth drawing, pixelsPerUnit the projected size
+// of one unit at distance one
+ViewFrustum makeViewFrustum(const glm::mat4& viewProjection, const glm::vec3& eye, float minPixels = 0.0f,
+    float pixelsPerUnit = 1.0f);
+
+bool sphereVisible(const ViewFrustum& frustum, const glm::vec3& center, float radius);
+
+// Write the indices of the visible spheres, in increasing order, to visible (room for count)
+// and return how many there are
+size_t cullSpheres(const ViewFrustum& frustum, const float* x, const float* y, const float* z, const float* radius,
+    size_t count, uint32_t* visible);
@@ -0,0 +1,124 @@
+#include "gl_state.h"
+
+GLStateCache glState;
+
+static GLuint queryBinding(GLenum binding) {
+    GLint value = 0;
+    glGetIntegerv(binding, &value);
+    return static_cast<GLuint>(value);
+}
+
+void GLStateCache::useProgram(GLuint program) {
+    if (program == currentProgram) return;
+    glUseProgram(program);
+    currentProgram = program;
+}
+
+void GLStateCache::bindVertexArray(GLuint vertexArray) {
+    if (vertexArray == currentVertexArray) return;
+    glBindVertexArray(vertexArray);
+    currentVertexArray = vertexArray;
+}
+
+void GLStateCache::bindArrayBuffer(GLuint buffer) {
+    if (buffer == currentArrayBuffer) return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    currentArrayBuffer = buffer;
+}
+
+void GLStateCache::bindFramebuffer(GLuint framebuffer) {
+    if (framebuffer == currentFramebuffer) return;
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    currentFramebuffer = framebuffer;
+}
+
+void GLStateCache::activeTexture(GLenum unit) {
+    if (unit == currentUnit) return;
+    glActiveTexture(unit);
+    currentUnit = unit;
+}
+
+int GLStateCache::activeUnit() {
+    if (currentUnit == UNKNOWN) currentUnit = queryBinding(GL_ACTIVE_TEXTURE);
+    return static_cast<int>(currentUnit - GL_TEXTURE0);
+}
+
+void GLStateCache::bindTexture2D(GLuint texture) {
+    int unit = activeUnit();
+    if (unit >= MAX_TEXTURE_UNITS) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        return;
+    }
+    if (texture == textures2D[unit]) return;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    textures2D[unit] = texture;
+}
+
+void GLStateCache::setCapability(GLenum capability, int& current, bool enabled) {
+    int wanted = enabled ? FLAG_ON : FLAG_OFF;
+    if (current == wanted) return;
+    if (enabled) glEnable(capability);
+    else glDisable(capability);
+    current = wanted;
+}
+
+int GLStateCache::queryCapability(GLenum capability, int& current) {
+    if (current == FLAG_UNKNOWN) current = glIsEnabled(capability) ? FLAG_ON : FLAG_OFF;
+    return current;
+}
+
+void GLStateCache::setBlend(bool enabled) {
+    setCapability(GL_BLEND, blendEnabled, enabled);
+}
+
+void GLStateCache::blendFunc(GLenum source, GLenum destination) {
+    if (source == blendSource && destination == blendDestination) return;
+    glBlendFunc(source, destination);
+    blendSource = source;
+    blendDestination = destination;
+}
+
+void GLStateCache::setDepthTest(bool enabled) {
+    setCapability(GL_DEPTH_TEST, depthTestEnabled, enabled);
+}
+
+void GLStateCache::setDepthMask(bool enabled) {
+    int wanted = enabled ? FLAG_ON : FLAG_OFF;
+    if (depthMaskEnabled == wanted) return;
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    depthMaskEnabled = wanted;
+}
+
+GLuint GLStateCache::program() {
+    if (currentProgram == UNKNOWN) currentProgram = queryBinding(GL_CURRENT_PROGRAM);
+    return currentProgram;
+}
+
+GLuint GLStateCache::vertexArray() {
+    if (currentVertexArray == UNKNOWN) currentVertexArray = queryBinding(GL_VERTEX_ARRAY_BINDING);
+    return currentVertexArray;
+}
+
+GLuint GLStateCache::arrayBuffer() {
+    if (currentArrayBuffer == UNKNOWN) currentArrayBuffer = queryBinding(GL_ARRAY_BUFFER_BINDING);
+    return currentArrayBuffer;
+}
+
+GLuint GLStateCache::texture2D() {
+    int unit = activeUnit();
+    if (unit >= MAX_TEXTURE_UNITS) return queryBinding(GL_TEXTURE_BINDING_2D);
+    if (textures2D[unit] == UNKNOWN) textures2D[unit] = queryBinding(GL_TEXTURE_BINDING_2D);
+    return textures2D[unit];
+}
+
+bool GLStateCache::blend() {
+    return queryCapability(GL_BLEND, blendEnabled) == FLAG_ON;
+}
+
+bool GLStateCache::depthTest() {
+    return queryCapability(GL_DEPTH_TEST, depthTestEnabled) == FLAG_ON;
+}
+
+void GLStateCache::invalidate() {
+    *this = GLStateCache();
+}
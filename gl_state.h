@@ -0,0 +1,59 @@
+#pragma once
+// Client-side mirror of the GL state the renderer changes while drawing.
+// All binds and enables go through glState. It skips calls that would set what is already
+// current and answers "what is bound?" from memory, so helpers can save and restore state
+// without glGet round trips to the driver. A value is only queried from GL if it hasn't been
+// set through the cache yet. Code that changes this state behind the cache's back must either
+// put it back as it found it (as ImGui's renderer does) or call invalidate(). The same goes
+// for deleting a bound object, which makes GL unbind it.
+//
+// Element array buffers are part of the bound VAO and aren't tracked.
+#include <glad/glad.h>
+
+class GLStateCache {
+public:
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vertexArray);
+    void bindArrayBuffer(GLuint buffer);
+    void bindFramebuffer(GLuint framebuffer);
+    void activeTexture(GLenum unit);
+    void bindTexture2D(GLuint texture); // On the active unit
+
+    void setBlend(bool enabled);
+    void blendFunc(GLenum source, GLenum destination);
+    void setDepthTest(bool enabled);
+    void setDepthMask(bool enabled);
+
+    GLuint program();
+    GLuint vertexArray();
+    GLuint arrayBuffer();
+    GLuint texture2D();
+    bool blend();
+    bool depthTest();
+
+    // Forget everything; the next call of each kind goes to GL
+    void invalidate();
+
+private:
+    static const GLuint UNKNOWN = 0xFFFFFFFFu;
+    static const int MAX_TEXTURE_UNITS = 8;
+    enum Flag { FLAG_UNKNOWN = -1, FLAG_OFF = 0, FLAG_ON = 1 };
+
+    int activeUnit();
+    static void setCapability(GLenum capability, int& current, bool enabled);
+    static int queryCapability(GLenum capability, int& current);
+
+    GLuint currentProgram = UNKNOWN;
+    GLuint currentVertexArray = UNKNOWN;
+    GLuint currentArrayBuffer = UNKNOWN;
+    GLuint currentFramebuffer = UNKNOWN;
+    GLenum currentUnit = UNKNOWN;
+    GLuint textures2D[MAX_TEXTURE_UNITS] = { UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN };
+    GLenum blendSource = UNKNOWN;
+    GLenum blendDestination = UNKNOWN;
+    int blendEnabled = FLAG_UNKNOWN;
+    int depthTestEnabled = FLAG_UNKNOWN;
+    int depthMaskEnabled = FLAG_UNKNOWN;
+};
+
+extern GLStateCache glState;
@@ -0,0 +1,171 @@
+#include "gpu_particles.h"
+#include "gl_state.h"
+#include "arena.h"
+#include <algorithm>
+
+// Stepping k simulation ticks of length h at once: velocity loses gravity * t, and the position
+// trails the exact parabola by the same 0.5 * g * h * t the CPU's per-tick steps build up
+static const char* updateVertexShaderSource = R"(
+#version 330 core
+layout (location = 0) in vec4 aPositionRotation;
+layout (location = 1) in vec4 aVelocityRotationSpeed;
+
+out vec4 PositionRotation;
+out vec4 VelocityRotationSpeed;
+
+uniform float blockStep[64];
+uniform int blockSize;
+uniform float gravity;
+uniform float tickLength;
+
+void main()
+{
+    float t = blockStep[gl_VertexID / blockSize];
+    vec3 velocity = aVelocityRotationSpeed.xyz;
+    float fall = 0.5 * gravity * t * (t - tickLength);
+
+    PositionRotation = vec4(aPositionRotation.xyz + velocity * t - vec3(0.0, fall, 0.0),
+        aPositionRotation.w + aVelocityRotationSpeed.w * t);
+    VelocityRotationSpeed = vec4(velocity.x, velocity.y - gravity * t, velocity.z, aVelocityRotationSpeed.w);
+}
+)";
+
+bool GpuParticles::init() {
+    const char* varyings[] = { "PositionRotation", "VelocityRotationSpeed" };
+    return updateProgram.createFeedback(updateVertexShaderSource, varyings, 2);
+}
+
+void GpuParticles::destroy() {
+    release();
+    updateProgram.destroy();
+}
+
+void GpuParticles::allocate(uint32_t blockCount, uint32_t blockSize) {
+    release();
+    blocks = blockCount;
+    particlesPerBlock = blockSize;
+    const size_t capacity = static_cast<size_t>(blockCount) * blockSize;
+
+    glGenBuffers(2, stateBuffers);
+    glGenVertexArrays(2, stateArrays);
+    for (int i = 0; i < 2; i++) {
+        glState.bindVertexArray(stateArrays[i]);
+        glState.bindArrayBuffer(stateBuffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(GpuParticleState), nullptr, GL_DYNAMIC_COPY);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(GpuParticleState), (void*)offsetof(GpuParticleState, position));
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(GpuParticleState), (void*)offsetof(GpuParticleState, velocity));
+        glEnableVertexAttribArray(1);
+    }
+    glState.bindVertexArray(0);
+
+    glGenBuffers(1, &looks);
+    glState.bindArrayBuffer(looks);
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(GpuParticleLook), nullptr, GL_STATIC_DRAW);
+
+    current = 0;
+    blockAge.assign(blockCount, 0.0f);
+    blockLive.assign(blockCount, 0);
+    blockStep.assign(blockCount, 0.0f);
+}
+
+void GpuParticles::release() {
+    if (!looks) return;
+    glState.bindVertexArray(0);
+    glState.bindArrayBuffer(0);
+    glDeleteVertexArrays(2, stateArrays);
+    glDeleteBuffers(2, stateBuffers);
+    glDeleteBuffers(1, &looks);
+    stateArrays[0] = stateArrays[1] = 0;
+    stateBuffers[0] = stateBuffers[1] = 0;
+    looks = 0;
+    blocks = 0;
+    particlesPerBlock = 0;
+}
+
+void GpuParticles::upload(const ParticlePool& pool, uint32_t firstParticle, uint32_t count) {
+    FrameVector<GpuParticleState> states(count);
+    FrameVector<GpuParticleLook> particleLooks(count);
+    for (uint32_t i = 0; i < count; i++) {
+        const uint32_t particle = firstParticle + i;
+        states[i].position = pool.position(particle);
+        states[i].rotation = pool.rotation[particle];
+        states[i].velocity = pool.particles.velocity(particle);
+        states[i].rotationSpeed = pool.rotationSpeed[particle];
+        particleLooks[i].size = pool.size[particle];
+        particleLooks[i].color = pool.color[particle];
+    }
+
+    glState.bindArrayBuffer(stateBuffers[current]);
+    glBufferSubData(GL_ARRAY_BUFFER, firstParticle * sizeof(GpuParticleState), count * sizeof(GpuParticleState), states.data());
+    glState.bindArrayBuffer(looks);
+    glBufferSubData(GL_ARRAY_BUFFER, firstParticle * sizeof(GpuParticleLook), count * sizeof(GpuParticleLook), particleLooks.data());
+}
+
+bool GpuParticles::update(const ParticlePool& pool, const GpuBurst* bursts, size_t burstCount, float gravity, float tickLength) {
+    if (!available() || pool.blockCount() == 0 || pool.blockCount() > MAX_BLOCKS) return false;
+    if (pool.blockCount() != blocks || pool.blockSize() != particlesPerBlock) {
+        allocate(pool.blockCount(), pool.blockSize());
+    }
+
+    // A block holds a new burst if it was empty last time or its burst got younger
+    FrameVector<unsigned char> seen(blocks, 0);
+    std::fill(blockStep.begin(), blockStep.end(), 0.0f);
+    bool moving = false;
+    for (size_t b = 0; b < burstCount; b++) {
+        const GpuBurst& burst = bursts[b];
+        const uint32_t block = burst.firstParticle / particlesPerBlock;
+        if (!blockLive[block] || burst.age < blockAge[block]) {
+            upload(pool, burst.firstParticle, burst.particleCount);
+            blockAge[block] = poolIsCurrent ? burst.age : 0.0f;
+        }
+        blockStep[block] = burst.age - blockAge[block];
+        blockAge[block] = burst.age;
+        seen[block] = 1;
+        moving = moving || blockStep[block] > 0.0f;
+    }
+    std::copy(seen.begin(), seen.end(), blockLive.begin());
+    poolIsCurrent = false;
+    if (!moving) return true;
+
+    // One pass over the whole pool; blocks without a live burst have a step of 0
+    updateProgram.use();
+    glUniform1fv(updateProgram.location("blockStep"), static_cast<GLsizei>(blocks), blockStep.data());
+    updateProgram.setInt("blockSize", static_cast<int>(particlesPerBlock));
+    updateProgram.setFloat("gravity", gravity);
+    updateProgram.setFloat("tickLength", tickLength);
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    glState.bindVertexArray(stateArrays[current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, stateBuffers[1 - current]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(blocks * particlesPerBlock));
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    current = 1 - current;
+    return true;
+}
+
+void GpuParticles::adoptPool() {
+    std::fill(blockLive.begin(), blockLive.end(), 0);
+    poolIsCurrent = true;
+}
+
+void GpuParticles::readBack(ParticlePool& pool) {
+    if (!looks || pool.blockCount() != blocks || pool.blockSize() != particlesPerBlock) return;
+
+    const size_t capacity = static_cast<size_t>(blocks) * particlesPerBlock;
+    std::vector<GpuParticleState> states(capacity);
+    glState.bindArrayBuffer(stateBuffers[current]);
+    glGetBufferSubData(GL_ARRAY_BUFFER, 0, capacity * sizeof(GpuParticleState), states.data());
+
+    for (uint32_t block = 0; block < blocks; block++) {
+        if (!blockLive[block]) continue;
+        for (uint32_t i = block * particlesPerBlock; i < (block + 1) * particlesPerBlock; i++) {
+            pool.set(i, states[i].position, states[i].velocity);
+            pool.rotation[i] = states[i].rotation;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+// Effect particle motion on the GPU through transform feedback.
+// A burst's particles are uploaded once, when the burst first shows up in the pool. From then
+// on a vertex shader moves every particle (position, velocity, rotation and gravity) from one
+// state buffer into the other each frame, and the effect shader draws straight from the
+// result, so the CPU neither integrates effect particles nor re-uploads them.
+//
+// The buffers mirror the ParticlePool layout: one block per burst, indexed by pool particle.
+// While this path is active the pool keeps each burst's spawn state and the simulation only
+// ages the bursts (see effectParticlesOnGpu).
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "particle_pool.h"
+#include "shader_program.h"
+
+// One live burst as the renderer sees it this frame
+struct GpuBurst {
+    uint32_t firstParticle;
+    uint32_t particleCount;
+    float age; // Simulated seconds since the burst spawned
+};
+
+// Per-particle state, rewritten every frame; laid out to match the update shader's outputs
+struct GpuParticleState {
+    glm::vec3 position;
+    float rotation;
+    glm::vec3 velocity;
+    float rotationSpeed;
+};
+
+// Per-particle data that never changes after spawn
+struct GpuParticleLook {
+    glm::vec3 size;
+    glm::vec3 color;
+};
+
+class GpuParticles {
+public:
+    static const uint32_t MAX_BLOCKS = 64; // Size of the update shader's blockStep array
+
+    // Compile the update program; false (and the CPU path stays in use) when that fails
+    bool init();
+    void destroy();
+    bool available() const { return updateProgram.id() != 0; }
+
+    // Follow the pool's layout, upload bursts seen for the first time and advance every live
+    // burst to its age. tickLength is the simulation step, which lets a frame covering several
+    // steps land exactly where the CPU kernels would. False when the pool doesn't fit.
+    bool update(const ParticlePool& pool, const GpuBurst* bursts, size_t burstCount, float gravity, float tickLength);
+
+    // Switching paths: take the pool's particles as they are now on the next update, or copy
+    // the GPU state back into the pool
+    void adoptPool();
+    void readBack(ParticlePool& pool);
+
+    GLuint stateBuffer() const { return stateBuffers[current]; } // GpuParticleState per pool particle
+    GLuint lookBuffer() const { return looks; }                  // GpuParticleLook per pool particle
+
+private:
+    void allocate(uint32_t blockCount, uint32_t blockSize);
+    void release();
+    void upload(const ParticlePool& pool, uint32_t firstParticle, uint32_t count);
+
+    ShaderProgram updateProgram;
+    GLuint stateBuffers[2] = { 0, 0 };
+    GLuint stateArrays[2] = { 0, 0 }; // VAO reading each state buffer
+    GLuint looks = 0;
+    int current = 0;
+
+    uint32_t blocks = 0;
+    uint32_t particlesPerBlock = 0;
+    std::vector<float> blockAge;          // Age the GPU copy of each block has been advanced to
+    std::vector<unsigned char> blockLive; // Block held a burst last update
+    std::vector<float> blockStep;         // Seconds to advance each block this update
+    bool poolIsCurrent = false;
+};
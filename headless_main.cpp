@@ -0,0 +1,259 @@
+// Headless driver: plays simulated matches with a simple bot, without a window, audio or GPU.
+// Used for balancing and profiling the gameplay simulation on build machines.
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "simulation.h"
+#include "job_system.h"
+#include "rng.h"
+#include "stress_config.h"
+
+// Driver options
+struct HeadlessOptions {
+    int matches = 1000;
+    float tickRate = 60.0f;       // Simulation ticks per second
+    float maxMatchTime = 300.0f;  // Simulated seconds before a match is cut off
+    uint64_t seed = 1;
+    int threads = 0;              // Job system workers; 0 runs everything on the main thread
+    size_t benchParticles = 0;    // When set, benchmark the particle kernels instead of playing
+    bool verbose = false;
+    StressConfig stress = defaultStressConfig();
+};
+
+// Match statistics
+struct HeadlessStats {
+    long long totalTicks = 0;
+    long long totalScore = 0;
+    int bestScore = 0;
+    int gamesOverNoLives = 0;
+    int gamesOverMisses = 0;
+    int gamesTimedOut = 0;
+    size_t peakEggs = 0;
+};
+
+HeadlessStats stats;
+
+void onHeadlessGameOver(GameOverReason reason) {
+    if (reason == GAME_OVER_NO_LIVES) stats.gamesOverNoLives++;
+    else stats.gamesOverMisses++;
+}
+
+void printUsage() {
+    std::cout << "Usage: JumpBallHeadless [options]" << std::endl;
+    std::cout << "  --matches N      Number of matches to simulate (default 1000)" << std::endl;
+    std::cout << "  --tick-rate HZ   Simulation ticks per second (default 60)" << std::endl;
+    std::cout << "  --max-time S     Simulated seconds before a match is cut off (default 300)" << std::endl;
+    std::cout << "  --seed N         Random seed of the first match (default 1)" << std::endl;
+    std::cout << "  --threads N      Job system worker threads, -1 for one per core (default 0)" << std::endl;
+    std::cout << "  --verbose        Print gameplay events" << std::endl;
+    std::cout << "  --bench-particles N  Benchmark the particle kernels on N particles and exit" << std::endl;
+    printStressOptions();
+}
+
+bool parseOptions(int argc, char** argv, HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--matches") == 0 && hasValue) {
+            options.matches = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--tick-rate") == 0 && hasValue) {
+            options.tickRate = static_cast<float>(atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--max-time") == 0 && hasValue) {
+            options.maxMatchTime = static_cast<float>(atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = static_cast<uint64_t>(strtoull(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--bench-particles") == 0 && hasValue) {
+            options.benchParticles = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        }
+        else if (parseStressOption(argc, argv, i, options.stress)) {
+        }
+        else {
+            printUsage();
+            return false;
+        }
+    }
+
+    if (options.matches <= 0 || options.tickRate <= 0.0f || options.maxMatchTime <= 0.0f) {
+        printUsage();
+        return false;
+    }
+    return true;
+}
+
+// Bot input: head for the closest regular egg and back away from chasing poison eggs
+void updateBotInput(float dt) {
+    if (!playerAlive) return;
+
+    glm::vec3 movement = glm::vec3(0.0f);
+    float closestDistance = 1e9f;
+
+    for (size_t i = 0; i < eggs.size(); i++) {
+        glm::vec3 toEgg = eggs.position(i) - playerPos;
+        toEgg.y = 0.0f;
+        float distance = glm::length(toEgg);
+
+        if (eggs.isPoison(i)) {
+            if (eggs.hasFlag(i, EGG_CHASING) && distance < 3.0f && distance > 0.001f) {
+                movement -= toEgg / distance * (3.0f - distance);
+            }
+        }
+        else if (distance < closestDistance) {
+            closestDistance = distance;
+            if (distance > 0.001f) {
+                movement += toEgg / distance;
+            }
+        }
+    }
+
+    if (glm::length(movement) > 0.0f) {
+        movement = glm::normalize(movement);
+        playerRotationTarget = atan2(movement.x, movement.z);
+        playerTargetPos += movement * playerSpeed * dt;
+        enforceWorldBoundaries(playerTargetPos);
+    }
+}
+
+// Particle kernel microbenchmark: run every supported ISA path over the same particles and
+// check that each one matches the scalar path. Returns false if any of them drifts apart.
+bool runParticleBenchmark(size_t count) {
+    const int steps = 200;
+    const float dt = 1.0f / 60.0f;
+    const float tolerance = 1e-5f; // Relative to the value's magnitude
+
+    ParticleArrays reference;
+    std::vector<float> referenceAngles;
+    bool allMatch = true;
+
+    std::cout << "Particle kernels: " << count << " particles, " << steps << " steps" << std::endl;
+    for (int isa = 0; isa < PARTICLE_ISA_COUNT; isa++) {
+        ParticleIsa particleIsa = static_cast<ParticleIsa>(isa);
+        if (!particleIsaSupported(particleIsa)) {
+            std::cout << "  " << particleIsaName(particleIsa) << ": not supported" << std::endl;
+            continue;
+        }
+        setParticleIsa(particleIsa);
+
+        ParticleArrays particles;
+        std::vector<float> angles(count);
+        std::vector<float> angleSpeeds(count);
+        particles.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            float f = static_cast<float>(i);
+            particles.push(glm::vec3(sinf(f) * 5.0f, 1.0f, cosf(f) * 5.0f),
+                glm::vec3(cosf(f * 0.7f) * 4.0f, 3.0f + sinf(f * 1.3f), sinf(f * 0.3f) * 4.0f));
+            angles[i] = f * 0.01f;
+            angleSpeeds[i] = sinf(f * 2.1f) * 5.0f;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 0; step < steps; step++) {
+            integrateParticles(particles, PARTICLE_GRAVITY, dt);
+            advanceValues(angles.data(), angleSpeeds.data(), count, dt);
+        }
+        double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        // The scalar path runs first and is the reference for the others
+        float maxError = 0.0f;
+        if (isa == PARTICLE_ISA_SCALAR) {
+            reference = particles;
+            referenceAngles = angles;
+        }
+        else {
+            const std::vector<float>* results[7] = { &particles.positionX, &particles.positionY, &particles.positionZ,
+                &particles.velocityX, &particles.velocityY, &particles.velocityZ, &angles };
+            const std::vector<float>* expected[7] = { &reference.positionX, &reference.positionY, &reference.positionZ,
+                &reference.velocityX, &reference.velocityY, &reference.velocityZ, &referenceAngles };
+            for (int array = 0; array < 7; array++) {
+                for (size_t i = 0; i < count; i++) {
+                    float want = (*expected[array])[i];
+                    float error = fabsf((*results[array])[i] - want) / std::max(1.0f, fabsf(want));
+                    maxError = std::max(maxError, error);
+                }
+            }
+        }
+
+        bool matches = maxError <= tolerance;
+        allMatch = allMatch && matches;
+        std::cout << "  " << particleIsaName(particleIsa) << ": " << count * steps / nanoseconds << " particles/ns, "
+            << "max relative difference " << maxError << (matches ? "" : " (FAILED)") << std::endl;
+    }
+
+    setParticleIsa(bestParticleIsa());
+    return allMatch;
+}
+
+int main(int argc, char** argv) {
+    HeadlessOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    if (options.benchParticles > 0) {
+        return runParticleBenchmark(options.benchParticles) ? 0 : 1;
+    }
+
+    simulationLogging = options.verbose;
+    simulationCallbacks.onGameOver = onHeadlessGameOver;
+    initJobSystem(options.threads);
+    applyStressConfig(options.stress);
+
+    const float tickInterval = 1.0f / options.tickRate;
+    const long long maxTicks = static_cast<long long>(options.maxMatchTime * options.tickRate);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int match = 0; match < options.matches; match++) {
+        seedRandomStreams(options.seed + match);
+        resetSimulation();
+        simulationTime = 0.0f;
+        currentGameState = GAME_PLAYING;
+
+        long long ticks = 0;
+        while (currentGameState == GAME_PLAYING && ticks < maxTicks) {
+            updateBotInput(tickInterval);
+            saveSimulationState();
+            stepSimulation(tickInterval);
+            ticks++;
+            stats.peakEggs = std::max(stats.peakEggs, eggs.size());
+        }
+
+        if (currentGameState == GAME_PLAYING) {
+            stats.gamesTimedOut++;
+        }
+
+        stats.totalTicks += ticks;
+        stats.totalScore += score;
+        if (score > stats.bestScore) stats.bestScore = score;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::cout << "Matches: " << options.matches << " at " << options.tickRate << " Hz" << std::endl;
+    std::cout << "Wall time: " << seconds << " s (" << options.matches / seconds << " matches/s, "
+        << stats.totalTicks / seconds << " ticks/s)" << std::endl;
+    std::cout << "Simulated time: " << stats.totalTicks * tickInterval << " s" << std::endl;
+    std::cout << "Average score: " << static_cast<double>(stats.totalScore) / options.matches
+        << ", best: " << stats.bestScore << std::endl;
+    std::cout << "Game over - no lives: " << stats.gamesOverNoLives
+        << ", too many misses: " << stats.gamesOverMisses
+        << ", timed out: " << stats.gamesTimedOut << std::endl;
+    std::cout << "Peak eggs: " << stats.peakEggs << " (arena " << GROUND_SIZE << ")" << std::endl;
+
+    shutdownJobSystem();
+    return 0;
+}
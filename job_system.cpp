@@ -0,0 +1,296 @@
+#include "job_system.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <cassert>
+
+const uint32_t JOB_CAPACITY = 4096; // Power of two; jobs are recycled round-robin
+static const int MAX_JOB_DEPENDENTS = 16;
+
+struct Job {
+    JobFunction function = nullptr;
+    JobRangeFunction rangeFunction = nullptr;
+    void* data = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+    std::atomic<int>* remaining = nullptr; // parallelFor chunk counter
+
+    std::atomic<uint32_t> generation{ 0 };
+    std::atomic<int> pendingDependencies{ 0 };
+    std::atomic<bool> finished{ false };
+
+    // Jobs waiting on this one; guarded by lock together with finished
+    std::mutex lock;
+    uint32_t dependents[MAX_JOB_DEPENDENTS];
+    int dependentCount = 0;
+};
+
+// Fixed ring of job indices. No more than JOB_CAPACITY jobs exist at once, so it never fills,
+// and pushing or popping never allocates.
+struct WorkerQueue {
+    std::mutex lock;
+    uint32_t jobs[JOB_CAPACITY];
+    uint32_t head = 0; // Oldest job
+    uint32_t tail = 0; // One past the newest job
+
+    bool empty() const { return head == tail; }
+    void pushBack(uint32_t index) { jobs[tail++ & (JOB_CAPACITY - 1)] = index; }
+    uint32_t popBack() { return jobs[--tail & (JOB_CAPACITY - 1)]; }
+    uint32_t popFront() { return jobs[head++ & (JOB_CAPACITY - 1)]; }
+};
+
+static Job* jobPool = nullptr;
+static std::atomic<uint32_t> nextJob{ 0 };
+static WorkerQueue* workerQueues = nullptr;
+static int queueCount = 1;
+static std::vector<std::thread> workerThreads;
+
+static std::atomic<bool> workersRunning{ false };
+static std::atomic<int> queuedJobs{ 0 };
+static std::mutex sleepLock;
+static std::condition_variable wakeWorkers;
+
+// Queue owned by the current thread; 0 is the main thread (and any other outside thread)
+static thread_local int currentQueue = 0;
+
+static bool runOneJob();
+
+static uint32_t allocateJob() {
+    uint32_t index = nextJob.fetch_add(1) & (JOB_CAPACITY - 1);
+    Job& job = jobPool[index];
+
+    // With more than JOB_CAPACITY jobs in flight the ring has come round to one still running;
+    // help out until it finishes rather than overwrite it
+    while (job.generation != 0 && !job.finished) {
+        if (!runOneJob()) std::this_thread::yield();
+    }
+
+    uint32_t generation = job.generation + 1;
+    if (generation == 0) generation = 1; // 0 is reserved for default handles
+    job.function = nullptr;
+    job.rangeFunction = nullptr;
+    job.data = nullptr;
+    job.remaining = nullptr;
+    job.dependentCount = 0;
+    job.pendingDependencies = 0;
+    job.finished = false;
+    job.generation = generation;
+    return index;
+}
+
+static void pushJob(uint32_t index) {
+    WorkerQueue& queue = workerQueues[currentQueue];
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.pushBack(index);
+    }
+    queuedJobs++;
+
+    // Taking the sleep lock orders this push against a worker checking queuedJobs before waiting
+    { std::lock_guard<std::mutex> guard(sleepLock); }
+    wakeWorkers.notify_one();
+}
+
+// Own queue from the back (most recent, still warm in cache), other queues from the front
+static bool popJob(uint32_t& index) {
+    {
+        WorkerQueue& queue = workerQueues[currentQueue];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (!queue.empty()) {
+            index = queue.popBack();
+            queuedJobs--;
+            return true;
+        }
+    }
+
+    for (int offset = 1; offset < queueCount; offset++) {
+        WorkerQueue& victim = workerQueues[(currentQueue + offset) % queueCount];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.empty()) {
+            index = victim.popFront();
+            queuedJobs--;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void finishJob(uint32_t index) {
+    Job& job = jobPool[index];
+
+    // Count the parallelFor chunk done before marking the job finished; from then on the slot
+    // may be reused
+    if (job.remaining) {
+        job.remaining->fetch_sub(1);
+    }
+
+    uint32_t dependents[MAX_JOB_DEPENDENTS];
+    int dependentCount;
+    {
+        std::lock_guard<std::mutex> guard(job.lock);
+        job.finished = true;
+        dependentCount = job.dependentCount;
+        for (int i = 0; i < dependentCount; i++) dependents[i] = job.dependents[i];
+    }
+
+    for (int i = 0; i < dependentCount; i++) {
+        if (--jobPool[dependents[i]].pendingDependencies == 0) {
+            pushJob(dependents[i]);
+        }
+    }
+}
+
+static bool runOneJob() {
+    uint32_t index;
+    if (!popJob(index)) return false;
+
+    Job& job = jobPool[index];
+    if (job.rangeFunction) job.rangeFunction(job.begin, job.end, job.data);
+    else job.function(job.data);
+
+    finishJob(index);
+    return true;
+}
+
+static void workerMain(int queue) {
+    currentQueue = queue;
+    while (workersRunning) {
+        if (!runOneJob()) {
+            std::unique_lock<std::mutex> guard(sleepLock);
+            wakeWorkers.wait(guard, [] { return queuedJobs > 0 || !workersRunning; });
+        }
+    }
+}
+
+void initJobSystem(int workerCount) {
+    if (jobPool) return;
+
+    if (workerCount < 0) {
+        int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    jobPool = new Job[JOB_CAPACITY];
+    queueCount = workerCount + 1;
+    workerQueues = new WorkerQueue[queueCount];
+
+    workersRunning = true;
+    for (int i = 0; i < workerCount; i++) {
+        workerThreads.emplace_back(workerMain, i + 1);
+    }
+}
+
+void shutdownJobSystem() {
+    if (!jobPool) return;
+
+    workersRunning = false;
+    { std::lock_guard<std::mutex> guard(sleepLock); }
+    wakeWorkers.notify_all();
+    for (auto& thread : workerThreads) {
+        thread.join();
+    }
+    workerThreads.clear();
+
+    delete[] workerQueues;
+    delete[] jobPool;
+    workerQueues = nullptr;
+    jobPool = nullptr;
+    queueCount = 1;
+}
+
+int jobWorkerCount() {
+    return static_cast<int>(workerThreads.size());
+}
+
+JobHandle scheduleJob(JobFunction function, void* data, const JobHandle* dependencies, int dependencyCount) {
+    // Without a job system, run right away (dependencies have necessarily finished already)
+    if (!jobPool) {
+        function(data);
+        return JobHandle();
+    }
+
+    uint32_t index = allocateJob();
+    Job& job = jobPool[index];
+    job.function = function;
+    job.data = data;
+
+    // Hold one extra count while registering so the job can't start half way through
+    job.pendingDependencies = 1;
+    for (int i = 0; i < dependencyCount; i++) {
+        const JobHandle& dependency = dependencies[i];
+        if (dependency.generation == 0) continue;
+
+        Job& parent = jobPool[dependency.index];
+        std::lock_guard<std::mutex> guard(parent.lock);
+        if (parent.generation == dependency.generation && !parent.finished) {
+            assert(parent.dependentCount < MAX_JOB_DEPENDENTS);
+            parent.dependents[parent.dependentCount++] = index;
+            job.pendingDependencies++;
+        }
+    }
+
+    JobHandle handle;
+    handle.index = index;
+    handle.generation = job.generation;
+
+    if (--job.pendingDependencies == 0) {
+        pushJob(index);
+    }
+    return handle;
+}
+
+bool isJobDone(JobHandle handle) {
+    if (handle.generation == 0) return true;
+    const Job& job = jobPool[handle.index];
+    return job.generation != handle.generation || job.finished;
+}
+
+void waitForJob(JobHandle handle) {
+    while (!isJobDone(handle)) {
+        if (!runOneJob()) std::this_thread::yield();
+    }
+}
+
+void waitForJobs(const JobHandle* handles, int count) {
+    for (int i = 0; i < count; i++) {
+        waitForJob(handles[i]);
+    }
+}
+
+void parallelFor(size_t count, size_t grainSize, JobRangeFunction function, void* data) {
+    if (count == 0) return;
+    if (grainSize == 0) grainSize = 1;
+
+    if (workerThreads.empty() || count <= grainSize) {
+        function(0, count, data);
+        return;
+    }
+
+    // A few chunks per thread is enough to balance load; more only adds queue traffic
+    const size_t maxChunks = static_cast<size_t>(queueCount) * 4;
+    if ((count + grainSize - 1) / grainSize > maxChunks) {
+        grainSize = (count + maxChunks - 1) / maxChunks;
+    }
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    // The caller takes the first chunk itself and pushes the rest
+    std::atomic<int> remaining(static_cast<int>(chunkCount - 1));
+    for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+        uint32_t index = allocateJob();
+        Job& job = jobPool[index];
+        job.rangeFunction = function;
+        job.data = data;
+        job.begin = chunk * grainSize;
+        job.end = job.begin + grainSize < count ? job.begin + grainSize : count;
+        job.remaining = &remaining;
+        pushJob(index);
+    }
+
+    function(0, grainSize, data);
+
+    while (remaining > 0) {
+        if (!runOneJob()) std::this_thread::yield();
+    }
+}
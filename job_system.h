@@ -0,0 +1,45 @@
+#pragma once
+// Work-stealing job system.
+// Every worker thread owns a queue; it runs its own newest jobs first and steals the oldest
+// jobs of other queues when it runs dry. Threads that wait on jobs help run them instead of
+// blocking, so jobs may schedule and wait on further jobs (for example a nested parallelFor).
+//
+// With no workers (the default until initJobSystem is called) everything runs inline on the
+// calling thread, so results never depend on the worker count.
+#include <cstddef>
+#include <cstdint>
+
+// Refers to a scheduled job. A default-constructed handle counts as already finished.
+struct JobHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+};
+
+typedef void (*JobFunction)(void* data);
+typedef void (*JobRangeFunction)(size_t begin, size_t end, void* data);
+
+// Start the worker threads. A negative count uses one worker per hardware thread, leaving one
+// for the caller.
+void initJobSystem(int workerCount);
+void shutdownJobSystem();
+int jobWorkerCount();
+
+// Run function(data) once all dependencies have finished. At most JOB_CAPACITY jobs may be in
+// flight at once, and data must stay alive until the job is done.
+JobHandle scheduleJob(JobFunction function, void* data, const JobHandle* dependencies = nullptr, int dependencyCount = 0);
+bool isJobDone(JobHandle handle);
+void waitForJob(JobHandle handle);
+void waitForJobs(const JobHandle* handles, int count);
+
+// Call function on [begin, end) chunks covering [0, count) and return once all of them ran.
+// Chunks hold at least grainSize items; at or below grainSize everything runs inline.
+void parallelFor(size_t count, size_t grainSize, JobRangeFunction function, void* data);
+
+template <typename Body>
+void parallelFor(size_t count, size_t grainSize, const Body& body) {
+    parallelFor(count, grainSize, [](size_t begin, size_t end, void* data) {
+        (*static_cast<const Body*>(data))(begin, end);
+    }, const_cast<void*>(static_cast<const void*>(&body)));
+}
+
+extern const uint32_t JOB_CAPACITY;
@@ -3,6 +3,8 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <map>
 #include <string>
 #include <glad/glad.h>
@@ -15,6 +17,18 @@
 #include <iomanip>
 #include <time.h>
 
+#include "simulation.h"
+#include "job_system.h"
+#include "rng.h"
+#include "stress_config.h"
+#include "shader_program.h"
+#include "gl_state.h"
+#include "static_geometry.h"
+#include "frustum_cull.h"
+#include "gpu_particles.h"
+#include "stream_buffer.h"
+#include "render_queue.h"
+
 // ImGui includes
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
@@ -36,20 +50,6 @@
 unsigned int SCR_WIDTH = 800;
 unsigned int SCR_HEIGHT = 600;
 
-// Game states
-enum GameState {
-    GAME_START,
-    GAME_PLAYING,
-    GAME_PAUSED,
-    GAME_OVER
-};
-
-GameState currentGameState = GAME_START;
-
-// World boundaries
-const float GROUND_SIZE = 20.0f;
-const float WORLD_BOUNDARY = GROUND_SIZE / 2.0f + 1.0f; // Slightly smaller than ground for visual margin
-
 // Sound effects
 Mix_Chunk* gCollectSound = nullptr;
 Mix_Chunk* gDeathSound = nullptr;
@@ -57,62 +57,7 @@ Mix_Chunk* gMissSound = nullptr;
 Mix_Chunk* gPoisonSound = nullptr;
 Mix_Music* gBackgroundMusic = nullptr;
 
-// Player properties
-glm::vec3 playerPos = glm::vec3(0.0f, 1.0f, 0.0f);
-glm::vec3 playerTargetPos = playerPos;
-float playerSpeed = 8.0f;
-float playerRadius = 0.6f;
-float playerRotation = 0.0f;
-float playerRotationTarget = 0.0f;
-bool playerAlive = true;
-float playerRespawnTimer = 0.0f;
-const float PLAYER_RESPAWN_TIME = 3.0f;
-
-
-// Egg properties
-struct Egg {
-    glm::vec3 position;
-    bool active;
-    float radius;
-    glm::vec3 color;
-    float spawnTime;
-    float lifeTimer;
-    float scale;
-    float pulseFactor;
-    bool spawning;
-    bool despawning;
-    bool isPoison; // New: distinguishes between collectible and poison eggs
-
-    // New AI properties for chasing
-    glm::vec3 velocity;
-    float chaseSpeed;
-    bool isChasing;
-    float chaseStartTime;
-};
-
-std::vector<Egg> eggs;
-float eggSpawnTimer = 0.0f;
-const float EGG_SPAWN_INTERVAL = 4.0f;
-const float EGG_LIFESPAN = 4.0f;
-const float EGG_RADIUS = 0.5f;
-const int MAX_EGGS = 10;
-
-// Poison egg properties
-float poisonEggSpawnTimer = 0.0f;
-const float POISON_EGG_SPAWN_INTERVAL = 6.0f;
-const float POISON_EGG_LIFESPAN = 6.0f;
-const float POISON_EGG_RADIUS = 0.6f;
-const int MAX_POISON_EGGS = 5;
-
-// Animation properties
-const float SPAWN_ANIMATION_DURATION = 1.0f;
-const float DESPAWN_ANIMATION_DURATION = 1.0f;
-const float PULSE_SPEED = 3.0f;
-const float POISON_PULSE_SPEED = 5.0f; // Faster pulse for poison eggs
-
 // Smooth damping properties
-float positionSmoothTime = 0.1f;
-float rotationSmoothTime = 0.05f;
 float cameraSmoothTime = 0.1f;
 
 // Camera properties
@@ -132,66 +77,8 @@ float cameraTargetAngle = cameraAngle;
 bool showSettings = false;
 
 // Game state
-int score = 0;
-int lives = 3;
 bool gameRunning = true;
 
-// Fruit Ninja style miss system
-int missedEggs = 0;
-const int MAX_MISSES = 3;
-std::vector<glm::vec3> missIndicators; // x,z for position, y for timer
-float missIndicatorDuration = 1.5f;
-
-// Enhanced collection effect properties (Fruit Ninja style)
-struct CollectionEffect {
-    glm::vec3 position;
-    glm::vec3 color;
-    float timer;
-    float duration;
-    bool active;
-    std::vector<glm::vec3> particlePositions;
-    std::vector<glm::vec3> particleVelocities;
-    std::vector<glm::vec3> particleSizes;
-    std::vector<float> particleRotations;
-    std::vector<float> particleRotationSpeeds;
-};
-
-std::vector<CollectionEffect> collectionEffects;
-const float COLLECTION_EFFECT_DURATION = 1.2f;
-const int COLLECTION_PARTICLES = 16; // More particles for better effect
-
-// Enhanced death effect
-struct DeathEffect {
-    glm::vec3 position;
-    float timer;
-    float duration;
-    bool active;
-    std::vector<glm::vec3> particlePositions;
-    std::vector<glm::vec3> particleVelocities;
-    std::vector<glm::vec3> particleSizes;
-    std::vector<glm::vec3> particleColors;
-};
-
-std::vector<DeathEffect> deathEffects;
-const float DEATH_EFFECT_DURATION = 2.0f;
-const int DEATH_PARTICLES = 20;
-
-// Trail effect properties
-struct TrailParticle {
-    glm::vec3 position;
-    glm::vec3 color;
-    float timer;
-    float duration;
-    float scale;
-};
-
-std::vector<TrailParticle> trailParticles;
-float trailSpawnTimer = 0.0f;
-float TRAIL_SPAWN_INTERVAL = 0.05f; // Spawn trail particle every 0.05 seconds
- float TRAIL_DURATION = 1.0f; // How long trail particles last
- float TRAIL_PARTICLE_SCALE = 0.5f; // Size of trail particles
-const int MAX_TRAIL_PARTICLES = 50; // Maximum number of trail particles
-
 // High score system
 int highScore = 0;
 const std::string HIGH_SCORE_FILE = "highscore.dat";
@@ -236,9 +123,32 @@ float mouseSensitivity = 0.1f;
 float scrollSensitivity = 0.5f;
 
 // Timing
-float deltaTime = 0.0f;
 float lastFrame = 0.0f;
 
+// Fixed timestep simulation
+bool useFixedTimestep = true;
+float simulationTickRate = 60.0f;      // Simulation ticks per second
+int maxSimulationStepsPerFrame = 5;    // Catch-up budget; older backlog is dropped after a hitch
+float simulationAccumulator = 0.0f;
+float renderAlpha = 1.0f;              // Interpolation factor between the previous and current tick
+int simulationStepsLastFrame = 0;
+
+// Each match is seeded from the clock unless the last seed is kept to replay the match
+bool replayMatchSeed = false;
+
+// Stress limits edited in the F1 panel; applied together with a reset
+StressConfig pendingStressConfig;
+bool groundMeshDirty = false; // GROUND_SIZE changed; rebuild the ground mesh
+
+// Camera position at the start of the current tick (for render interpolation)
+glm::vec3 previousCameraPos = glm::vec3(0.0f, 3.0f, 8.0f);
+
+// Camera smooth damping velocities
+glm::vec3 cameraPosVelocity = glm::vec3(0.0f);
+float cameraDistanceVelocity = 0.0f;
+float cameraHeightVelocity = 0.0f;
+float cameraAngleVelocity = 0.0f;
+
 // Postprocessing effects
 struct PostProcessEffect {
     float timer;
@@ -256,7 +166,7 @@ unsigned int framebuffer;
 unsigned int textureColorbuffer;
 unsigned int rbo;
 unsigned int postprocessVAO, postprocessVBO;
-unsigned int postprocessShaderProgram;
+ShaderProgram postprocessShaderProgram;
 
 // Text rendering structures
 struct Character {
@@ -267,8 +177,9 @@ struct Character {
 };
 
 std::map<char, Character> Characters;
-unsigned int textVAO, textVBO;
-unsigned int textShaderProgram;
+unsigned int textVAO;
+ShaderProgram textShaderProgram;
+ShaderProgram overlayShaderProgram;
 
 // Settings system
 const std::string SETTINGS_FILE = "game_settings.dat";
@@ -305,12 +216,35 @@ GameSettings currentSettings;
 
 // Egg icon texture and rendering
 unsigned int eggIconTexture;
-unsigned int iconVAO, iconVBO;
-unsigned int iconShaderProgram;
+unsigned int iconVAO;
+ShaderProgram iconShaderProgram;
 
 // Trail texture
 unsigned int trailTexture;
 
+// Per-frame camera data shared by every 3D shader. All of them read it from one uniform buffer
+// (cameraUBO) that is written once per frame; CameraUniforms mirrors its std140 layout.
+#define CAMERA_UNIFORM_BLOCK \
+    "layout (std140) uniform Camera\n" \
+    "{\n" \
+    "    mat4 view;\n" \
+    "    mat4 projection;\n" \
+    "    vec3 lightPos;\n" \
+    "    vec3 viewPos;\n" \
+    "};\n"
+
+struct CameraUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 lightPos;
+    float lightPosPadding; // std140 pads vec3 to 16 bytes
+    glm::vec3 viewPos;
+    float viewPosPadding;
+};
+
+const GLuint CAMERA_UNIFORM_BINDING = 0;
+unsigned int cameraUBO;
+
 // Vertex shader source
 const char* vertexShaderSource = R"(
 #version 330 core
@@ -320,14 +254,14 @@ layout (location = 1) in vec3 aNormal;
 out vec3 FragPos;
 out vec3 Normal;
 
+)" CAMERA_UNIFORM_BLOCK R"(
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat3 normalMatrix; // Inverse transpose of model, computed once per draw on the CPU
 
 void main()
 {
     FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    Normal = normalMatrix * aNormal;
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
 )";
@@ -340,9 +274,8 @@ out vec4 FragColor;
 in vec3 FragPos;
 in vec3 Normal;
 
+)" CAMERA_UNIFORM_BLOCK R"(
 uniform vec3 objectColor;
-uniform vec3 lightPos;
-uniform vec3 viewPos;
 
 void main()
 {
@@ -373,9 +306,8 @@ const char* missVertexShaderSource = R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
 
+)" CAMERA_UNIFORM_BLOCK R"(
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
 
 void main()
 {
@@ -395,18 +327,114 @@ void main()
 }
 )";
 
-// Effect shader
+// Instanced egg shader. Every instance carries its own position, scale, color and chase
+// state, so all eggs of one type go out in a single draw.
+const char* eggVertexShaderSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec4 aPositionScale; // Per instance: interpolated position, spawn/despawn scale
+layout (location = 3) in vec4 aColorPulse;    // Per instance: base color, pulse factor
+layout (location = 4) in float aChasing;      // Per instance: 1 while a poison egg chases the player
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 Color;
+
+)" CAMERA_UNIFORM_BLOCK R"(
+uniform bool poison;
+
+void main()
+{
+    // Eggs are only translated and uniformly scaled, so the normal needs no transform
+    FragPos = aPositionScale.xyz + aPos * (aPositionScale.w * aColorPulse.w);
+    Normal = aNormal;
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+
+    // Make poison eggs more vibrant, especially when chasing
+    if (poison)
+        Color = aChasing > 0.5 ? mix(aColorPulse.rgb, vec3(1.0, 0.0, 0.0), 0.3) : aColorPulse.rgb * 1.2;
+    else
+        Color = aColorPulse.rgb;
+}
+)";
+
+// Same lighting as the main fragment shader, with the color coming from the instance
+const char* eggFragmentShaderSource = R"(
+#version 330 core
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec3 Color;
+
+)" CAMERA_UNIFORM_BLOCK R"(
+void main()
+{
+    float ambientStrength = 0.3;
+    vec3 ambient = ambientStrength * vec3(1.0);
+
+    vec3 norm = normalize(Normal);
+    vec3 lightDir = normalize(lightPos - FragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * vec3(1.0);
+
+    float specularStrength = 0.5;
+    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+    vec3 specular = specularStrength * spec * vec3(1.0);
+
+    vec3 result = (ambient + diffuse + specular) * Color;
+    FragColor = vec4(result, 1.0);
+}
+)";
+
+// Effect shader, instanced: one instance per effect particle
 const char* effectVertexShaderSource = R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec4 aPositionRotation; // Per instance: world position, rotation about Y
+layout (location = 3) in vec4 aSizeAlpha;        // Per instance: scale per axis, alpha
+layout (location = 4) in vec3 aColor;            // Per instance
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+out vec4 EffectColor;
 
+)" CAMERA_UNIFORM_BLOCK R"(
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    vec3 scaled = aPos * aSizeAlpha.xyz;
+    float c = cos(aPositionRotation.w);
+    float s = sin(aPositionRotation.w);
+    vec3 rotated = vec3(c * scaled.x + s * scaled.z, scaled.y, c * scaled.z - s * scaled.x);
+    gl_Position = projection * view * vec4(aPositionRotation.xyz + rotated, 1.0);
+    EffectColor = vec4(aColor, aSizeAlpha.w);
+}
+)";
+
+// Effect particles moved on the GPU: position and rotation come from the particle state buffer,
+// size and color from the spawn data, and the fade is shared by the whole burst
+const char* gpuEffectVertexShaderSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec4 aPositionRotation; // Per instance: world position, rotation about Y
+layout (location = 3) in vec3 aSize;             // Per instance: scale per axis at spawn
+layout (location = 4) in vec3 aColor;            // Per instance
+
+out vec4 EffectColor;
+
+)" CAMERA_UNIFORM_BLOCK R"(
+uniform float shrink;
+uniform float alpha;
+
+void main()
+{
+    vec3 scaled = aPos * (aSize * shrink);
+    float c = cos(aPositionRotation.w);
+    float s = sin(aPositionRotation.w);
+    vec3 rotated = vec3(c * scaled.x + s * scaled.z, scaled.y, c * scaled.z - s * scaled.x);
+    gl_Position = projection * view * vec4(aPositionRotation.xyz + rotated, 1.0);
+    EffectColor = vec4(aColor, alpha);
 }
 )";
 
@@ -414,12 +442,11 @@ const char* effectFragmentShaderSource = R"(
 #version 330 core
 out vec4 FragColor;
 
-uniform vec3 effectColor;
-uniform float alpha;
+in vec4 EffectColor;
 
 void main()
 {
-    FragColor = vec4(effectColor, alpha);
+    FragColor = EffectColor;
 }
 )";
 
@@ -555,21 +582,36 @@ void main()
 
 
 // Trail shader sources
+// Instanced trail billboards. Each quad is turned to face the camera using the view matrix's
+// right and up rows, and fades and shrinks with its age.
 const char* trailVertexShaderSource = R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 aPositionScale; // Per instance: world position, full scale
+layout (location = 3) in vec3 aColor;         // Per instance
+layout (location = 4) in vec2 aAgeDuration;   // Per instance: seconds alive, lifetime
 
 out vec2 TexCoord;
+out vec3 TrailColor;
+out float Alpha;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
+)" CAMERA_UNIFORM_BLOCK R"(
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    float progress = aAgeDuration.x / aAgeDuration.y;
+
+    // Shrink to 30% over the particle's life, and never below that
+    float scale = max(aPositionScale.w * (1.0 - progress * 0.7), aPositionScale.w * 0.3);
+
+    vec3 cameraRight = vec3(view[0][0], view[1][0], view[2][0]);
+    vec3 cameraUp = vec3(view[0][1], view[1][1], view[2][1]);
+    vec3 worldPos = aPositionScale.xyz + (cameraRight * aPos.x + cameraUp * aPos.y) * scale;
+
+    gl_Position = projection * view * vec4(worldPos, 1.0);
     TexCoord = aTexCoord;
+    TrailColor = aColor;
+    Alpha = (1.0 - progress) * 0.8;
 }
 )";
 
@@ -578,20 +620,20 @@ const char* trailFragmentShaderSource = R"(
 out vec4 FragColor;
 
 in vec2 TexCoord;
+in vec3 TrailColor;
+in float Alpha;
 
 uniform sampler2D trailTexture;
-uniform vec3 trailColor;
-uniform float alpha;
 
 void main()
 {
     vec4 texColor = texture(trailTexture, TexCoord);
     
-    // Use texture alpha and apply uniform alpha for fading
-    float finalAlpha = texColor.a * alpha;
+    // Use texture alpha and apply the particle's alpha for fading
+    float finalAlpha = texColor.a * Alpha;
     
     // Mix texture color with trail color
-    vec3 finalColor = mix(texColor.rgb, trailColor, 0.3);
+    vec3 finalColor = mix(texColor.rgb, TrailColor, 0.3);
     
     FragColor = vec4(finalColor, finalAlpha);
     
@@ -601,45 +643,199 @@ void main()
 }
 )";
 
-unsigned int compileShader(unsigned int type, const char* source) {
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
-
-    int success;
-    char infoLog[512];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
+// Full-screen tint drawn behind the pause, game over and high score screens, using the
+// postprocessing quad
+const char* overlayVertexShaderSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+void main() { gl_Position = vec4(aPos, 0.0, 1.0); }
+)";
+
+const char* overlayFragmentShaderSource = R"(
+#version 330 core
+out vec4 FragColor;
+uniform vec4 overlayColor;
+void main() { FragColor = overlayColor; }
+)";
+
+// Text, icon, trail, egg and effect particle vertices are written here every frame
+StreamBuffer streamBuffer;
+const size_t STREAM_BUFFER_SIZE = 1 << 20; // Grows if a frame needs more
 
-    return shader;
+// Per-egg instance data, laid out to match attributes 2-4 of the egg shader
+struct EggInstance {
+    glm::vec3 position;
+    float scale;
+    glm::vec3 color;
+    float pulse;
+    float chasing;
+};
+
+void setupEggInstanceAttributes(unsigned int vao) {
+    glState.bindVertexArray(vao);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+    glState.bindVertexArray(0);
 }
 
-unsigned int createShaderProgram(const char* vertexSource, const char* fragmentSource) {
-    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
-    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
-
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    int success;
-    char infoLog[512];
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-    }
+// Point the bound VAO's instance attributes at instances written to the stream buffer at offset.
+// GL 3.3 has no base instance for draws, so each LOD's range of instances is selected this way.
+void pointEggInstanceAttributes(size_t offset, size_t firstInstance) {
+    const size_t base = offset + firstInstance * sizeof(EggInstance);
+    glState.bindArrayBuffer(streamBuffer.id());
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(EggInstance), (void*)(base + offsetof(EggInstance, position)));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(EggInstance), (void*)(base + offsetof(EggInstance, color)));
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(EggInstance), (void*)(base + offsetof(EggInstance, chasing)));
+}
+
+// Per-particle instance data, laid out to match attributes 2-4 of the effect shader
+struct ParticleInstance {
+    glm::vec3 position;
+    float rotation;
+    glm::vec3 size;
+    float alpha;
+    glm::vec3 color;
+};
+
+void setupParticleInstanceAttributes(unsigned int vao) {
+    glState.bindVertexArray(vao);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+    glState.bindVertexArray(0);
+}
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+// Point the bound VAO's instance attributes at instances written to the stream buffer at offset
+void pointParticleInstanceAttributes(size_t offset) {
+    glState.bindArrayBuffer(streamBuffer.id());
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)(offset + offsetof(ParticleInstance, position)));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)(offset + offsetof(ParticleInstance, size)));
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)(offset + offsetof(ParticleInstance, color)));
+}
 
-    return shaderProgram;
+// GPU particles are drawn per burst straight from the GpuParticles buffers
+void setupGpuParticleAttributes(unsigned int vao) {
+    glState.bindVertexArray(vao);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+    glState.bindVertexArray(0);
 }
 
+// Point the bound VAO's instance attributes at one burst, like pointEggInstanceAttributes
+void pointGpuParticleAttributes(const GpuParticles& particles, uint32_t firstParticle) {
+    const size_t stateBase = firstParticle * sizeof(GpuParticleState);
+    const size_t lookBase = firstParticle * sizeof(GpuParticleLook);
+    glState.bindArrayBuffer(particles.stateBuffer());
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(GpuParticleState), (void*)(stateBase + offsetof(GpuParticleState, position)));
+    glState.bindArrayBuffer(particles.lookBuffer());
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(GpuParticleLook), (void*)(lookBase + offsetof(GpuParticleLook, size)));
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(GpuParticleLook), (void*)(lookBase + offsetof(GpuParticleLook, color)));
+}
+
+GpuParticles gpuParticles;
+bool useGpuParticles = true; // Move effect particles on the GPU when it can
+
+// Setup data and functions for the render queue's packets (see DrawPacket::setup)
+
+// Ground and player, with the lit mesh shader
+struct MeshDraw {
+    glm::mat4 model;
+    glm::vec3 color;
+};
+
+void setupMeshDraw(ShaderProgram& program, const void* data) {
+    const MeshDraw& draw = *static_cast<const MeshDraw*>(data);
+    program.setMat4("model", draw.model);
+    program.setMat3("normalMatrix", glm::mat3(glm::transpose(glm::inverse(draw.model))));
+    program.setVec3("objectColor", draw.color);
+}
+
+// One egg type's instances at one LOD
+struct EggDraw {
+    size_t offset; // Of the type's instances in the stream buffer
+    size_t firstInstance;
+    int poison;
+};
+
+void setupEggDraw(ShaderProgram& program, const void* data) {
+    const EggDraw& draw = *static_cast<const EggDraw*>(data);
+    program.setInt("poison", draw.poison);
+    pointEggInstanceAttributes(draw.offset, draw.firstInstance);
+}
+
+struct CrossDraw {
+    glm::mat4 model;
+    float alpha;
+};
+
+void setupCrossDraw(ShaderProgram& program, const void* data) {
+    const CrossDraw& draw = *static_cast<const CrossDraw*>(data);
+    program.setMat4("model", draw.model);
+    program.setFloat("alpha", draw.alpha);
+}
+
+// CPU effect particles; data is the instances' offset in the stream buffer
+void setupParticleDraw(ShaderProgram&, const void* data) {
+    pointParticleInstanceAttributes(*static_cast<const size_t*>(data));
+}
+
+// One burst of GPU effect particles
+struct GpuBurstDraw {
+    uint32_t firstParticle;
+    float shrink;
+    float alpha;
+};
+
+void setupGpuBurstDraw(ShaderProgram& program, const void* data) {
+    const GpuBurstDraw& draw = *static_cast<const GpuBurstDraw*>(data);
+    program.setFloat("shrink", draw.shrink);
+    program.setFloat("alpha", draw.alpha);
+    pointGpuParticleAttributes(gpuParticles, draw.firstParticle);
+}
+
+// Switch effect particles between the CPU kernels and the GPU, handing their current state over
+void setGpuParticles(bool enabled) {
+    enabled = enabled && gpuParticles.available();
+    if (enabled == effectParticlesOnGpu) return;
+
+    if (enabled) gpuParticles.adoptPool();
+    else gpuParticles.readBack(effectParticles);
+    effectParticlesOnGpu = enabled;
+}
+
+// Bring the GPU particles up to the simulation's bursts after this frame's ticks. frameTime is
+// the single step taken without a fixed timestep.
+void updateGpuParticles(float frameTime) {
+    if (!effectParticlesOnGpu) return;
+
+    FrameVector<GpuBurst> bursts;
+    bursts.reserve(collectionEffects.size() + deathEffects.size());
+    for (const auto& effect : collectionEffects) {
+        bursts.push_back({ effect.firstParticle, effect.particleCount, effect.duration - effect.timer });
+    }
+    for (const auto& effect : deathEffects) {
+        bursts.push_back({ effect.firstParticle, effect.particleCount, effect.duration - effect.timer });
+    }
+
+    // The closed-form step only matches the CPU kernels given the length of the ticks they take
+    const float tickLength = useFixedTimestep ? 1.0f / simulationTickRate : frameTime;
+    if (!gpuParticles.update(effectParticles, bursts.data(), bursts.size(), PARTICLE_GRAVITY, tickLength)) {
+        std::cout << "Effect pool too large for GPU particles, using the CPU" << std::endl;
+        setGpuParticles(false);
+        useGpuParticles = false;
+    }
+}
 
 // Generate quad geometry for trail particles
 void generateTrailQuad(std::vector<float>& vertices, std::vector<unsigned int>& indices) {
@@ -661,11 +857,11 @@ void generateTrailQuad(std::vector<float>& vertices, std::vector<unsigned int>&
 void initPostProcessing() {
     // Create framebuffer
     glGenFramebuffers(1, &framebuffer);
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glState.bindFramebuffer(framebuffer);
 
     // Create texture attachment
     glGenTextures(1, &textureColorbuffer);
-    glBindTexture(GL_TEXTURE_2D, textureColorbuffer);
+    glState.bindTexture2D(textureColorbuffer);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -681,7 +877,7 @@ void initPostProcessing() {
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << std::endl;
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glState.bindFramebuffer(0);
 
     // Create postprocessing quad
     float quadVertices[] = {
@@ -697,8 +893,8 @@ void initPostProcessing() {
 
     glGenVertexArrays(1, &postprocessVAO);
     glGenBuffers(1, &postprocessVBO);
-    glBindVertexArray(postprocessVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, postprocessVBO);
+    glState.bindVertexArray(postprocessVAO);
+    glState.bindArrayBuffer(postprocessVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
@@ -706,7 +902,7 @@ void initPostProcessing() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
 
     // Create postprocessing shader
-    postprocessShaderProgram = createShaderProgram(postprocessVertexShaderSource, postprocessFragmentShaderSource);
+    postprocessShaderProgram.create(postprocessVertexShaderSource, postprocessFragmentShaderSource);
 }
 
 void triggerScreenShake() {
@@ -1131,577 +1327,59 @@ void submitHighScore() {
         playerNameInput = "Player";
     }
 
-    // Update player profile with new name
-    currentPlayer.playerName = playerNameInput;
-    addHighScore(playerNameInput, score);
-    showHighScoreInput = false;
-    newHighScoreAchieved = false;
-
-    // Save the updated profile
-    updatePlayerProfile();
-}
-
-// Boundary checking function
-void enforceWorldBoundaries(glm::vec3& position) {
-    float boundary = WORLD_BOUNDARY - playerRadius;
-    // X boundary
-    position.x = glm::clamp(position.x, -boundary, boundary);
-
-    // Z boundary 
-    position.z = glm::clamp(position.z, -boundary, boundary);
-
-    // Y boundary (ground collision)
-    position.y = glm::max(position.y, playerRadius);
-}
-
-// Smooth damping functions
-glm::vec3 smoothDamp(glm::vec3 current, glm::vec3 target, glm::vec3& currentVelocity, float smoothTime, float deltaTime) {
-    float omega = 2.0f / smoothTime;
-    float x = omega * deltaTime;
-    float exp = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
-
-    glm::vec3 change = current - target;
-    glm::vec3 temp = (currentVelocity + omega * change) * deltaTime;
-    currentVelocity = (currentVelocity - omega * temp) * exp;
-    glm::vec3 output = target + (change + temp) * exp;
-
-    return output;
-}
-
-float smoothDamp(float current, float target, float& currentVelocity, float smoothTime, float deltaTime) {
-    float omega = 2.0f / smoothTime;
-    float x = omega * deltaTime;
-    float exp = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
-
-    float change = current - target;
-    float temp = (currentVelocity + omega * change) * deltaTime;
-    currentVelocity = (currentVelocity - omega * temp) * exp;
-    float output = target + (change + temp) * exp;
-
-    return output;
-}
-
-// Generate random position for eggs
-glm::vec3 generateRandomEggPosition() {
-    float boundary = WORLD_BOUNDARY - EGG_RADIUS - 1.0f; // Keep eggs away from edges
-    float x = ((float)rand() / RAND_MAX) * 2.0f * boundary - boundary;
-    float z = ((float)rand() / RAND_MAX) * 2.0f * boundary - boundary;
-    return glm::vec3(x, EGG_RADIUS, z);
-}
-
-// Generate random color for eggs
-glm::vec3 generateRandomEggColor() {
-    return glm::vec3(
-        (float)rand() / RAND_MAX * 0.5f + 0.5f, // R: 0.5-1.0
-        (float)rand() / RAND_MAX * 0.5f + 0.5f, // G: 0.5-1.0
-        (float)rand() / RAND_MAX * 0.5f + 0.5f  // B: 0.5-1.0
-    );
-}
-
-// Spawn a new egg
-void spawnEgg() {
-    // Remove any inactive eggs first to keep the list clean
-    eggs.erase(std::remove_if(eggs.begin(), eggs.end(),
-        [](const Egg& egg) { return !egg.active; }), eggs.end());
-
-    // Only spawn if we have room for more eggs and game is active
-    int activeEggCount = std::count_if(eggs.begin(), eggs.end(),
-        [](const Egg& egg) { return egg.active && !egg.isPoison; });
-
-    if (activeEggCount < MAX_EGGS && currentGameState == GAME_PLAYING) {
-        Egg newEgg;
-        newEgg.position = generateRandomEggPosition();
-        newEgg.active = true;
-        newEgg.radius = EGG_RADIUS;
-        newEgg.color = generateRandomEggColor();
-        newEgg.spawnTime = glfwGetTime();
-        newEgg.lifeTimer = EGG_LIFESPAN;
-        newEgg.scale = 0.0f; // Start at scale 0 for spawn animation
-        newEgg.pulseFactor = 0.0f;
-        newEgg.spawning = true;
-        newEgg.despawning = false;
-        newEgg.isPoison = false;
-
-        // Initialize AI properties for regular eggs (not used, but for consistency)
-        newEgg.velocity = glm::vec3(0.0f);
-        newEgg.chaseSpeed = 0.0f;
-        newEgg.isChasing = false;
-        newEgg.chaseStartTime = 0.0f;
-
-        eggs.push_back(newEgg);
-        std::cout << "Egg spawned at (" << newEgg.position.x << ", " << newEgg.position.z << ")" << std::endl;
-    }
-}
-
-// Spawn a poison egg
-void spawnPoisonEgg() {
-    // Remove any inactive eggs first to keep the list clean
-    eggs.erase(std::remove_if(eggs.begin(), eggs.end(),
-        [](const Egg& egg) { return !egg.active; }), eggs.end());
-
-    int poisonEggCount = std::count_if(eggs.begin(), eggs.end(),
-        [](const Egg& egg) { return egg.active && egg.isPoison; });
-
-    if (poisonEggCount < MAX_POISON_EGGS && currentGameState == GAME_PLAYING) {
-        Egg poisonEgg;
-        poisonEgg.position = generateRandomEggPosition();
-        poisonEgg.active = true;
-        poisonEgg.radius = POISON_EGG_RADIUS;
-        poisonEgg.color = glm::vec3(0.6f, 0.2f, 0.8f);
-        poisonEgg.spawnTime = glfwGetTime();
-        poisonEgg.lifeTimer = POISON_EGG_LIFESPAN;
-        poisonEgg.scale = 0.0f;
-        poisonEgg.pulseFactor = 0.0f;
-        poisonEgg.spawning = true;
-        poisonEgg.despawning = false;
-        poisonEgg.isPoison = true;
-
-        // New AI initialization
-        poisonEgg.velocity = glm::vec3(0.0f);
-        poisonEgg.chaseSpeed = 3.0f; // Adjust this value for different difficulty
-        poisonEgg.isChasing = false;
-        poisonEgg.chaseStartTime = 1.0f; // Start chasing after 1 second
-
-        eggs.push_back(poisonEgg);
-        std::cout << "POISON EGG spawned at (" << poisonEgg.position.x << ", " << poisonEgg.position.z << ")" << std::endl;
-    }
-}
-
-// Enhanced collection effect creation (Fruit Ninja style)
-void createCollectionEffect(const glm::vec3& position, const glm::vec3& color) {
-   
-    playCollectSound();
-    CollectionEffect effect;
-    effect.position = position;
-    effect.color = color;
-    effect.timer = COLLECTION_EFFECT_DURATION;
-    effect.duration = COLLECTION_EFFECT_DURATION;
-    effect.active = true;
-
-    // Create particles for burst effect - Fruit Ninja style
-    for (int i = 0; i < COLLECTION_PARTICLES; i++) {
-        // Random direction in a more controlled burst pattern
-        float angle = (float)i / COLLECTION_PARTICLES * 2.0f * 3.14159f;
-        float spread = 0.3f + ((float)rand() / RAND_MAX) * 0.7f;
-        float speed = 3.0f + ((float)rand() / RAND_MAX) * 4.0f;
-
-        glm::vec3 velocity = glm::vec3(
-            cos(angle) * speed * spread,
-            1.5f + ((float)rand() / RAND_MAX) * 3.0f, // More upward velocity
-            sin(angle) * speed * spread
-        );
-
-        // Random particle size (like fruit chunks in Fruit Ninja)
-        glm::vec3 size = glm::vec3(
-            0.1f + ((float)rand() / RAND_MAX) * 0.2f,
-            0.1f + ((float)rand() / RAND_MAX) * 0.2f,
-            0.1f + ((float)rand() / RAND_MAX) * 0.2f
-        );
-
-        effect.particlePositions.push_back(position);
-        effect.particleVelocities.push_back(velocity);
-        effect.particleSizes.push_back(size);
-        effect.particleRotations.push_back((float)rand() / RAND_MAX * 6.28318f);
-        effect.particleRotationSpeeds.push_back(((float)rand() / RAND_MAX - 0.5f) * 10.0f);
-    }
-
-    collectionEffects.push_back(effect);
-    std::cout << "Collection effect created at (" << position.x << ", " << position.z << ")" << std::endl;
-}
-
-// Enhanced death effect creation
-void createDeathEffect(const glm::vec3& position) {
-    playDeathSound();
-    DeathEffect effect;
-    effect.position = position;
-    effect.timer = DEATH_EFFECT_DURATION;
-    effect.duration = DEATH_EFFECT_DURATION;
-    effect.active = true;
-
-    // Create particles for death explosion
-    for (int i = 0; i < DEATH_PARTICLES; i++) {
-        // Random spherical direction for explosion
-        float theta = ((float)rand() / RAND_MAX) * 2.0f * 3.14159f;
-        float phi = acos(2.0f * ((float)rand() / RAND_MAX) - 1.0f);
-        float speed = 3.0f + ((float)rand() / RAND_MAX) * 4.0f;
-
-        glm::vec3 velocity = glm::vec3(
-            sin(phi) * cos(theta) * speed,
-            sin(phi) * sin(theta) * speed,
-            cos(phi) * speed
-        );
-
-        // Random particle size
-        glm::vec3 size = glm::vec3(
-            0.15f + ((float)rand() / RAND_MAX) * 0.25f,
-            0.15f + ((float)rand() / RAND_MAX) * 0.25f,
-            0.15f + ((float)rand() / RAND_MAX) * 0.25f
-        );
-
-        // Purple color with some variation
-        glm::vec3 particleColor = glm::vec3(
-            0.6f + ((float)rand() / RAND_MAX) * 0.3f,
-            0.1f + ((float)rand() / RAND_MAX) * 0.2f,
-            0.7f + ((float)rand() / RAND_MAX) * 0.2f
-        );
-
-        effect.particlePositions.push_back(position);
-        effect.particleVelocities.push_back(velocity);
-        effect.particleSizes.push_back(size);
-        effect.particleColors.push_back(particleColor);
-    }
-
-    deathEffects.push_back(effect);
-    std::cout << "Death effect created at (" << position.x << ", " << position.z << ")" << std::endl;
-}
-
-// Update collection effects
-void updateCollectionEffects() {
-    for (auto& effect : collectionEffects) {
-        if (effect.active) {
-            effect.timer -= deltaTime;
-
-            // Update particle positions and rotations
-            for (size_t i = 0; i < effect.particlePositions.size(); i++) {
-                effect.particlePositions[i] += effect.particleVelocities[i] * deltaTime;
-                // Apply gravity
-                effect.particleVelocities[i].y -= 9.8f * deltaTime;
-                // Update rotation
-                effect.particleRotations[i] += effect.particleRotationSpeeds[i] * deltaTime;
-            }
-
-            // Deactivate when timer expires
-            if (effect.timer <= 0.0f) {
-                effect.active = false;
-            }
-        }
-    }
-
-    // Remove inactive effects
-    collectionEffects.erase(std::remove_if(collectionEffects.begin(), collectionEffects.end(),
-        [](const CollectionEffect& effect) { return !effect.active; }), collectionEffects.end());
-}
-
-// Update death effects
-void updateDeathEffects() {
-    for (auto& effect : deathEffects) {
-        if (effect.active) {
-            effect.timer -= deltaTime;
-
-            // Update particle positions
-            for (size_t i = 0; i < effect.particlePositions.size(); i++) {
-                effect.particlePositions[i] += effect.particleVelocities[i] * deltaTime;
-                // Apply gravity
-                effect.particleVelocities[i].y -= 9.8f * deltaTime;
-            }
-
-            // Deactivate when timer expires
-            if (effect.timer <= 0.0f) {
-                effect.active = false;
-            }
-        }
-    }
-
-    // Remove inactive effects
-    deathEffects.erase(std::remove_if(deathEffects.begin(), deathEffects.end(),
-        [](const DeathEffect& effect) { return !effect.active; }), deathEffects.end());
-}
-
-// Update trail effects
-void updateTrailEffects() {
-    // Only update trails during gameplay
-    if (currentGameState != GAME_PLAYING) return;
-
-    // Update existing trail particles
-    for (auto it = trailParticles.begin(); it != trailParticles.end(); ) {
-        it->timer -= deltaTime;
-
-        if (it->timer <= 0.0f) {
-            it = trailParticles.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
-
-    // Spawn new trail particles when player is moving and alive
-    if (playerAlive) {
-        trailSpawnTimer += deltaTime;
-
-        // Check if player is actually moving (position changed)
-        static glm::vec3 lastPlayerPos = playerPos;
-        bool isMoving = glm::distance(playerPos, lastPlayerPos) > 0.01f;
-        lastPlayerPos = playerPos;
-
-        if (isMoving && trailSpawnTimer >= TRAIL_SPAWN_INTERVAL) {
-            // Remove oldest particle if we're at the limit
-            if (trailParticles.size() >= MAX_TRAIL_PARTICLES) {
-                trailParticles.erase(trailParticles.begin());
-            }
-
-            TrailParticle newParticle;
-            newParticle.position = playerPos - glm::vec3(0.0f, playerRadius * 0.5f, 0.0f); // Position below player
-            newParticle.color = glm::vec3(0.8f, 0.2f, 0.2f); // Red color matching player
-            newParticle.timer = TRAIL_DURATION;
-            newParticle.duration = TRAIL_DURATION;
-            newParticle.scale = TRAIL_PARTICLE_SCALE;
-
-            trailParticles.push_back(newParticle);
-            trailSpawnTimer = 0.0f;
-        }
-    }
-}
-
-// Player death function
-void killPlayer() {
-    if (playerAlive) {
-        playerAlive = false;
-        lives--;
-        playerRespawnTimer = PLAYER_RESPAWN_TIME;
-
-        // Trigger screen shake effect
-        triggerScreenShake();
-
-        // Check for game over due to no lives
-        if (lives <= 0) {
-            currentGameState = GAME_OVER;
-
-            // Stop the screen shake effect when game over is triggered
-            stopScreenShake();
-
-            checkForHighScore(); // Check if this is a new high score
-            updatePlayerProfile(); // Save profile with game results
-            std::cout << "GAME OVER! Final Score: " << score << std::endl;
-            std::cout << "Reason: No lives remaining!" << std::endl;
-        }
-        else {
-            std::cout << "Player died! Lives remaining: " << lives << std::endl;
-        }
-    }
-}
-
-// Respawn player
-void respawnPlayer() {
-    playerPos = glm::vec3(0.0f, 1.0f, 0.0f);
-    playerTargetPos = playerPos;
-    playerAlive = true;
-    std::cout << "Player respawned!" << std::endl;
-}
-
-// Check for missed eggs (Fruit Ninja style)
-// In the checkForMissedEggs() function, update the game over condition:
-void checkForMissedEggs() {
-    for (auto it = eggs.begin(); it != eggs.end(); ) {
-        if (it->active && !it->isPoison && it->lifeTimer <= 0.0f) {
-            playMissSound();
-            // Egg expired without being collected - this is a miss!
-            missedEggs++;
-
-            // Add miss indicator at egg position (world space)
-            glm::vec3 missIndicator = glm::vec3(it->position.x, missIndicatorDuration, it->position.z);
-            missIndicators.push_back(missIndicator);
-
-            std::cout << "Missed egg! Misses: " << missedEggs << "/" << MAX_MISSES << std::endl;
-
-            // Check for game over due to too many misses
-            if (missedEggs >= MAX_MISSES) {
-                currentGameState = GAME_OVER;
-
-                // Stop any active screen shake effect
-                stopScreenShake();
-
-                checkForHighScore(); // Check if this is a new high score
-                std::cout << "GAME OVER! Too many missed eggs! Final Score: " << score << std::endl;
-            }
-
-            // Remove the expired egg
-            it = eggs.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
-}
-
-// Update miss indicators
-void updateMissIndicators() {
-    // Remove expired miss indicators
-    missIndicators.erase(std::remove_if(missIndicators.begin(), missIndicators.end(),
-        [](const glm::vec3& indicator) {
-            return indicator.y <= 0.0f; // Use y component as timer
-        }), missIndicators.end());
-
-    // Update timers for active indicators
-    for (auto& indicator : missIndicators) {
-        indicator.y -= deltaTime; // Decrease timer (stored in y component)
-    }
-}
-
-// Update egg animations and lifecycle
-void updateEggs() {
-    // Don't update eggs if game is not playing
-    if (currentGameState != GAME_PLAYING) return;
-
-    // Update spawn timers
-    eggSpawnTimer += deltaTime;
-    poisonEggSpawnTimer += deltaTime;
-
-    // Spawn new egg if timer reaches interval
-    if (eggSpawnTimer >= EGG_SPAWN_INTERVAL) {
-        spawnEgg();
-        eggSpawnTimer = 0.0f;
-    }
-
-    // Spawn poison egg if timer reaches interval
-    if (poisonEggSpawnTimer >= POISON_EGG_SPAWN_INTERVAL) {
-        spawnPoisonEgg();
-        poisonEggSpawnTimer = 0.0f;
-    }
-
-    // Update all eggs
-    for (auto& egg : eggs) {
-        if (egg.active) {
-            // Update life timer
-            egg.lifeTimer -= deltaTime;
-
-            // AI CHASING BEHAVIOR FOR POISON EGGS
-            if (egg.isPoison && playerAlive && currentGameState == GAME_PLAYING) {
-                // Start chasing after initial delay and if spawn animation is complete
-                if (!egg.spawning && egg.lifeTimer < (POISON_EGG_LIFESPAN - egg.chaseStartTime)) {
-                    egg.isChasing = true;
-
-                    // Calculate direction to player
-                    glm::vec3 direction = playerPos - egg.position;
-                    direction.y = 0.0f; // Keep movement on horizontal plane
-
-                    // Normalize direction and apply speed
-                    if (glm::length(direction) > 0.1f) {
-                        direction = glm::normalize(direction);
-                        egg.velocity = direction * egg.chaseSpeed;
-
-                        // Update position with velocity
-                        egg.position += egg.velocity * deltaTime;
-
-                        // Optional: Add some vertical bobbing for visual effect
-                        egg.position.y = EGG_RADIUS + sin(glfwGetTime() * 8.0f) * 0.1f;
-                    }
-                }
-                else if (egg.spawning) {
-                    // Reset velocity during spawn animation
-                    egg.velocity = glm::vec3(0.0f);
-                    egg.isChasing = false;
-                }
-            }
-
-            // Update pulse animation (continuous pulsing)
-            float pulseSpeed = egg.isPoison ? POISON_PULSE_SPEED : PULSE_SPEED;
-            egg.pulseFactor = sin(glfwGetTime() * pulseSpeed) * 0.1f + 1.0f; // Pulse between 0.9 and 1.1
-
-            // Handle spawn animation
-            if (egg.spawning) {
-                float spawnProgress = 1.0f - (egg.lifeTimer / (egg.isPoison ? POISON_EGG_LIFESPAN : EGG_LIFESPAN));
-                float spawnDuration = egg.isPoison ? SPAWN_ANIMATION_DURATION * 0.7f : SPAWN_ANIMATION_DURATION;
-                if (spawnProgress < spawnDuration / (egg.isPoison ? POISON_EGG_LIFESPAN : EGG_LIFESPAN)) {
-                    // Scale up during spawn animation
-                    egg.scale = spawnProgress * ((egg.isPoison ? POISON_EGG_LIFESPAN : EGG_LIFESPAN) / spawnDuration);
-                }
-                else {
-                    // Spawn animation complete
-                    egg.scale = 1.0f;
-                    egg.spawning = false;
-                }
-            }
-
-            // Handle despawn animation
-            float despawnDuration = egg.isPoison ? DESPAWN_ANIMATION_DURATION * 0.7f : DESPAWN_ANIMATION_DURATION;
-            if (egg.lifeTimer <= despawnDuration && !egg.despawning) {
-                egg.despawning = true;
-                // Stop chasing when despawning starts
-                if (egg.isPoison) {
-                    egg.isChasing = false;
-                    egg.velocity = glm::vec3(0.0f);
-                }
-            }
+    // Update player profile with new name
+    currentPlayer.playerName = playerNameInput;
+    addHighScore(playerNameInput, score);
+    showHighScoreInput = false;
+    newHighScoreAchieved = false;
 
-            if (egg.despawning) {
-                // Scale down during despawn animation
-                float despawnProgress = egg.lifeTimer / despawnDuration;
-                egg.scale = despawnProgress;
-            }
+    // Save the updated profile
+    updatePlayerProfile();
+}
 
-            // Check for collisions with player (only if player is alive)
-            if (playerAlive) {
-                float distance = glm::distance(playerPos, egg.position);
-                float collisionDistance = playerRadius + egg.radius * egg.scale;
-
-                if (distance < collisionDistance) {
-                    if (egg.isPoison) {
-                        //playPoisonSound();
-                        // Poison egg - kill player immediately
-                        createDeathEffect(egg.position); // Add death effect
-                        killPlayer();
-                        egg.active = false;
-                        std::cout << "Player hit poison egg! Lives: " << lives << std::endl;
-                    }
-                    else {
-                        // Regular egg - collect and score
-                        createCollectionEffect(egg.position, egg.color); // Add collection effect
-                        egg.active = false;
-                        score += 10;
-                        std::cout << "Egg collected! Score: " << score << std::endl;
-                    }
-                }
-            }
+// Simulation event handlers: sounds, screen shake and high scores
+void onCollectionEffect(const glm::vec3& /*position*/) {
+    playCollectSound();
+}
 
-            // Deactivate poison eggs if lifespan is over (regular eggs are handled in checkForMissedEggs)
-            if (egg.isPoison && egg.lifeTimer <= 0.0f) {
-                egg.active = false;
-                std::cout << "Poison egg despawned!" << std::endl;
-            }
-        }
-    }
+void onDeathEffect(const glm::vec3& /*position*/) {
+    playDeathSound();
+}
+
+void onEggMissed(const glm::vec3& /*position*/) {
+    playMissSound();
+}
 
-    // Remove inactive eggs (only poison eggs, regular eggs are removed in checkForMissedEggs)
-    eggs.erase(std::remove_if(eggs.begin(), eggs.end(),
-        [](const Egg& egg) { return !egg.active && egg.isPoison; }), eggs.end());
+void onPlayerKilled() {
+    triggerScreenShake();
 }
 
-// Update player respawn
-void updatePlayer() {
-    if (currentGameState != GAME_PLAYING) return; // Don't update player if game not playing
+void onGameOver(GameOverReason reason) {
+    // Stop the screen shake effect when game over is triggered
+    stopScreenShake();
 
-    if (!playerAlive && currentGameState == GAME_PLAYING) {
-        playerRespawnTimer -= deltaTime;
-        if (playerRespawnTimer <= 0.0f) {
-            respawnPlayer();
-        }
+    checkForHighScore(); // Check if this is a new high score
+    if (reason == GAME_OVER_NO_LIVES) {
+        updatePlayerProfile(); // Save profile with game results
     }
 }
 
+// Pick the random seed for a new match
+uint64_t newMatchSeed() {
+    static Pcg32 seedGenerator(static_cast<uint64_t>(time(nullptr)), 0);
+    return seedGenerator.next64();
+}
+
 // Reset game function
 void resetGame() {
-    score = 0;
-    lives = 3;
-    missedEggs = 0;
-    playerAlive = true;
-    eggs.clear();
-    missIndicators.clear();
-    collectionEffects.clear();
-    deathEffects.clear();
-    trailParticles.clear(); // Clear trail particles on reset
-    playerPos = glm::vec3(0.0f, 1.0f, 0.0f);
-    playerTargetPos = playerPos;
-    playerRotation = 0.0f;
-    playerRotationTarget = 0.0f;
-    eggSpawnTimer = 0.0f;
-    poisonEggSpawnTimer = 0.0f;
-    playerRespawnTimer = 0.0f;
-    trailSpawnTimer = 0.0f; // Reset trail timer
+    seedRandomStreams(replayMatchSeed ? randomMatchSeed() : newMatchSeed());
+    resetSimulation();
+    simulationAccumulator = 0.0f;
     newHighScoreAchieved = false;
     showHighScoreInput = false;
     // Don't reset playerNameInput - keep the current profile name
 
-    std::cout << "Game reset! Ready for new game." << std::endl;
+    std::cout << "Game reset! Ready for new game. Match seed: " << randomMatchSeed() << std::endl;
 }
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
@@ -1710,19 +1388,19 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 
     // Update framebuffer size
-    glBindTexture(GL_TEXTURE_2D, textureColorbuffer);
+    glState.bindTexture2D(textureColorbuffer);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
     glBindRenderbuffer(GL_RENDERBUFFER, rbo);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, SCR_WIDTH, SCR_HEIGHT);
 
     // Update text projection matrix when window is resized
-    glUseProgram(textShaderProgram);
+    textShaderProgram.use();
     glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(SCR_WIDTH), 0.0f, static_cast<float>(SCR_HEIGHT));
-    glUniformMatrix4fv(glGetUniformLocation(textShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    textShaderProgram.setMat4("projection", projection);
 
     // Update icon projection matrix
-    glUseProgram(iconShaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(iconShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    iconShaderProgram.use();
+    iconShaderProgram.setMat4("projection", projection);
 }
 
 // Update camera vectors based on current camera angle
@@ -1739,6 +1417,64 @@ void updateCamera() {
     cameraTargetPos = playerPos + glm::vec3(camX, cameraHeight, camZ);
 }
 
+// Advance the game simulation and the presentation state that follows it by one step
+void updateSimulation(float dt) {
+    saveSimulationState();
+    previousCameraPos = cameraPos;
+
+    stepSimulation(dt);
+
+    // Update postprocessing effects
+    updatePostProcessing();
+
+    // Apply smooth damping to camera parameters
+    cameraDistance = smoothDamp(cameraDistance, cameraTargetDistance, cameraDistanceVelocity, cameraSmoothTime, deltaTime);
+    cameraHeight = smoothDamp(cameraHeight, cameraTargetHeight, cameraHeightVelocity, cameraSmoothTime, deltaTime);
+    cameraAngle = smoothDamp(cameraAngle, cameraTargetAngle, cameraAngleVelocity, cameraSmoothTime, deltaTime);
+
+    // Apply smooth damping to camera position
+    cameraPos = smoothDamp(cameraPos, cameraTargetPos, cameraPosVelocity, cameraSmoothTime, deltaTime);
+
+    // Update camera vectors after smooth damping
+    updateCameraVectors();
+}
+
+// Run the simulation for this frame: a whole number of fixed ticks (bounded by the catch-up budget)
+// or a single variable step, leaving renderAlpha set for interpolation
+void runSimulation(float frameTime) {
+    simulationStepsLastFrame = 0;
+
+    if (!useFixedTimestep) {
+        updateSimulation(frameTime);
+        simulationStepsLastFrame = 1;
+        renderAlpha = 1.0f;
+        return;
+    }
+
+    const float tickInterval = 1.0f / simulationTickRate;
+    simulationAccumulator += frameTime;
+
+    while (simulationAccumulator >= tickInterval && simulationStepsLastFrame < maxSimulationStepsPerFrame) {
+        updateSimulation(tickInterval);
+        simulationAccumulator -= tickInterval;
+        simulationStepsLastFrame++;
+
+        // The game may have ended mid-frame; don't keep ticking a finished match
+        if (currentGameState != GAME_PLAYING) {
+            simulationAccumulator = 0.0f;
+            renderAlpha = 1.0f;
+            return;
+        }
+    }
+
+    // Out of budget: drop the backlog instead of spiralling further behind
+    if (simulationAccumulator >= tickInterval) {
+        simulationAccumulator = fmod(simulationAccumulator, tickInterval);
+    }
+
+    renderAlpha = simulationAccumulator / tickInterval;
+}
+
 void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
     // Check if ImGui wants to capture the mouse
     ImGuiIO& io = ImGui::GetIO();
@@ -2305,7 +2041,7 @@ unsigned int loadTexture(const char* path) {
             format = GL_RGBA;
         }
 
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        glState.bindTexture2D(textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
         glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -2326,7 +2062,7 @@ unsigned int loadTexture(const char* path) {
             255, 255, 255, 255, 255, 0, 0, 255
         };
 
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        glState.bindTexture2D(textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, fallbackData);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -2346,7 +2082,7 @@ void loadTrailTexture() {
 
     // If texture failed to load, create fallback
     GLint textureWidth, textureHeight;
-    glBindTexture(GL_TEXTURE_2D, trailTexture);
+    glState.bindTexture2D(trailTexture);
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &textureWidth);
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &textureHeight);
 
@@ -2358,14 +2094,24 @@ void loadTrailTexture() {
     }
 }
 
-unsigned int trailShaderProgram;
+ShaderProgram trailShaderProgram;
 unsigned int trailVAO, trailVBO, trailEBO;
 std::vector<float> trailVertices;
 std::vector<unsigned int> trailIndices;
 
+// Per-trail-particle instance data, laid out to match attributes 2-4 of the trail shader
+struct TrailInstance {
+    glm::vec3 position;
+    float scale;
+    glm::vec3 color;
+    float age;
+    float duration;
+};
+
 void initTrailRendering() {
     // Compile trail shader
-    trailShaderProgram = createShaderProgram(trailVertexShaderSource, trailFragmentShaderSource);
+    trailShaderProgram.create(trailVertexShaderSource, trailFragmentShaderSource);
+    trailShaderProgram.bindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
 
     // Generate quad geometry
     generateTrailQuad(trailVertices, trailIndices);
@@ -2375,9 +2121,9 @@ void initTrailRendering() {
     glGenBuffers(1, &trailVBO);
     glGenBuffers(1, &trailEBO);
 
-    glBindVertexArray(trailVAO);
+    glState.bindVertexArray(trailVAO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, trailVBO);
+    glState.bindArrayBuffer(trailVBO);
     glBufferData(GL_ARRAY_BUFFER, trailVertices.size() * sizeof(float), trailVertices.data(), GL_STATIC_DRAW);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, trailEBO);
@@ -2391,31 +2137,27 @@ void initTrailRendering() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    glBindVertexArray(0);
+    // Per-instance attributes, pointed into the stream buffer at each draw
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    glState.bindVertexArray(0);
 }
 
 // Initialize icon rendering
 void initIconRendering() {
     // Compile shader
-    iconShaderProgram = createShaderProgram(iconVertexShaderSource, iconFragmentShaderSource);
+    iconShaderProgram.create(iconVertexShaderSource, iconFragmentShaderSource);
 
-    // Create VAO and VBO
+    // Create VAO; each icon's quad is written to the stream buffer and drawn from where it lands
     glGenVertexArrays(1, &iconVAO);
-    glGenBuffers(1, &iconVBO);
-
-    glBindVertexArray(iconVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, iconVBO);
 
-    // Initialize with some data (will be updated each frame)
-    float vertices[] = {
-        0.0f, 0.0f, 0.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 0.0f
-    };
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
+    glState.bindVertexArray(iconVAO);
+    glState.bindArrayBuffer(streamBuffer.id());
 
     // Set vertex attributes
     glEnableVertexAttribArray(0);
@@ -2423,7 +2165,7 @@ void initIconRendering() {
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
 
-    glBindVertexArray(0);
+    glState.bindVertexArray(0);
 
     // Load texture
     std::cout << "Loading egg icon texture..." << std::endl;
@@ -2431,7 +2173,7 @@ void initIconRendering() {
 
     // Test if texture is valid
     GLint textureWidth, textureHeight;
-    glBindTexture(GL_TEXTURE_2D, eggIconTexture);
+    glState.bindTexture2D(eggIconTexture);
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &textureWidth);
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &textureHeight);
     std::cout << "Egg icon texture dimensions: " << textureWidth << "x" << textureHeight << std::endl;
@@ -2444,31 +2186,30 @@ void initIconRendering() {
 // Render egg icon
 void RenderEggIcon(float x, float y, float width, float height, glm::vec3 color) {
     // Save current state
-    GLint last_program, last_texture, last_array_buffer, last_vertex_array;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
-    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
+    GLuint last_program = glState.program();
+    GLuint last_texture = glState.texture2D();
+    GLuint last_array_buffer = glState.arrayBuffer();
+    GLuint last_vertex_array = glState.vertexArray();
 
     // Enable blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST);
+    glState.setBlend(true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setDepthTest(false);
 
     // Use icon shader
-    glUseProgram(iconShaderProgram);
+    iconShaderProgram.use();
 
     // Set up orthographic projection
     glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(SCR_WIDTH), 0.0f, static_cast<float>(SCR_HEIGHT));
-    glUniformMatrix4fv(glGetUniformLocation(iconShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniform3f(glGetUniformLocation(iconShaderProgram, "iconColor"), color.x, color.y, color.z);
+    iconShaderProgram.setMat4("projection", projection);
+    iconShaderProgram.setVec3("iconColor", color);
 
     // Bind texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, eggIconTexture);
+    glState.activeTexture(GL_TEXTURE0);
+    glState.bindTexture2D(eggIconTexture);
 
     // Bind VAO
-    glBindVertexArray(iconVAO);
+    glState.bindVertexArray(iconVAO);
 
     // Calculate vertices for the quad at the specified position and size
     float x0 = x;
@@ -2487,91 +2228,143 @@ void RenderEggIcon(float x, float y, float width, float height, glm::vec3 color)
         x1, y1, 1.0f, 1.0f   // top-right
     };
 
-    // Update VBO
-    glBindBuffer(GL_ARRAY_BUFFER, iconVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-
-    // Draw
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    // Write the quad and draw it
+    const size_t vertexStride = 4 * sizeof(float);
+    const size_t offset = streamBuffer.write(vertices, sizeof(vertices), vertexStride);
+    glDrawArrays(GL_TRIANGLES, static_cast<GLint>(offset / vertexStride), 6);
 
     // Restore state
-    glBindVertexArray(last_vertex_array);
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-    glUseProgram(last_program);
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
+    glState.bindVertexArray(last_vertex_array);
+    glState.bindArrayBuffer(last_array_buffer);
+    glState.bindTexture2D(last_texture);
+    glState.useProgram(last_program);
+    glState.setDepthTest(true);
+    glState.setBlend(false);
+}
+
+// Objects smaller than this on screen (projected radius, in pixels) are culled
+const float CULL_MIN_PIXELS = 0.25f;
+
+// How many objects of one kind were considered and culled in the last frame
+struct CullCounts {
+    int total = 0;
+    int culled = 0;
+};
+
+// Far clipping plane of the 3D view, which render queue depths are measured against
+const float CAMERA_FAR_PLANE = 100.0f;
+
+// Groups of transparent draws, blended in this order whatever their depth
+enum TransparentLayer {
+    LAYER_TRAILS,
+    LAYER_MISS_CROSSES,
+    LAYER_EFFECT_PARTICLES,
+};
+
+// Point the bound VAO's instance attributes at trail instances written to the stream buffer at offset
+void pointTrailInstanceAttributes(size_t offset) {
+    glState.bindArrayBuffer(streamBuffer.id());
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(TrailInstance), (void*)(offset + offsetof(TrailInstance, position)));
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(TrailInstance), (void*)(offset + offsetof(TrailInstance, color)));
+    glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(TrailInstance), (void*)(offset + offsetof(TrailInstance, age)));
+}
+
+// Trail instances in the stream buffer; data is their offset
+void setupTrailDraw(ShaderProgram& program, const void* data) {
+    program.setInt("trailTexture", 0);
+    pointTrailInstanceAttributes(*static_cast<const size_t*>(data));
 }
 
-// Render trail effects
-void renderTrailEffects(const glm::mat4& view, const glm::mat4& projection) {
+// Submit trail effects as one instanced draw, skipping particles outside the view
+void submitTrailEffects(const ViewFrustum& frustum, CullCounts& cullCounts, RenderQueue& queue) {
     if (trailParticles.empty()) return;
 
-    // Save current state
-    GLint last_program, last_texture;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
-
-    // Use trail shader
-    glUseProgram(trailShaderProgram);
-
-    // Set view and projection
-    glUniformMatrix4fv(glGetUniformLocation(trailShaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(trailShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-
-    // Bind trail texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, trailTexture);
-    glUniform1i(glGetUniformLocation(trailShaderProgram, "trailTexture"), 0);
-
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask(GL_FALSE);
-
-    // Use trail VAO
-    glBindVertexArray(trailVAO);
-
-    // Extract camera vectors for billboarding
-    glm::vec3 cameraRight = glm::vec3(view[0][0], view[1][0], view[2][0]);
-    glm::vec3 cameraUp = glm::vec3(view[0][1], view[1][1], view[2][1]);
-
-    for (const auto& particle : trailParticles) {
-        // Calculate fade based on timer
-        float progress = 1.0f - (particle.timer / particle.duration);
-        float alpha = (1.0f - progress) * 0.8f;
-
-        // Create model matrix with billboarding
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, particle.position);
-
-        // Billboarding matrix
-        glm::mat4 billboardRotation = glm::mat4(1.0f);
-        billboardRotation[0] = glm::vec4(cameraRight, 0.0f);
-        billboardRotation[1] = glm::vec4(cameraUp, 0.0f);
-        billboardRotation[2] = glm::vec4(glm::cross(cameraRight, cameraUp), 0.0f);
-
-        model = model * billboardRotation;
-
-        // Controlled scaling with minimum size
-        float finalScale = particle.scale * (1.0f - progress * 0.7f);
-        finalScale = glm::max(finalScale, particle.scale * 0.3f);
-        model = glm::scale(model, glm::vec3(finalScale));
-
-        // Set shader uniforms
-        glUniformMatrix4fv(glGetUniformLocation(trailShaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-        glUniform3fv(glGetUniformLocation(trailShaderProgram, "trailColor"), 1, glm::value_ptr(particle.color));
-        glUniform1f(glGetUniformLocation(trailShaderProgram, "alpha"), alpha);
-
-        // Draw the trail particle
-        glDrawElements(GL_TRIANGLES, trailIndices.size(), GL_UNSIGNED_INT, 0);
+    // Bounding spheres use the particle's largest scale; the quad's corners are sqrt(0.5) from its center
+    const size_t particleCount = trailParticles.size();
+    FrameVector<float> boundX(particleCount), boundY(particleCount), boundZ(particleCount), boundRadius(particleCount);
+    for (size_t i = 0; i < particleCount; i++) {
+        boundX[i] = trailParticles[i].position.x;
+        boundY[i] = trailParticles[i].position.y;
+        boundZ[i] = trailParticles[i].position.z;
+        boundRadius[i] = trailParticles[i].scale * 0.7072f;
+    }
+    FrameVector<uint32_t> visibleParticles(particleCount);
+    visibleParticles.resize(cullSpheres(frustum, boundX.data(), boundY.data(), boundZ.data(), boundRadius.data(),
+        particleCount, visibleParticles.data()));
+    cullCounts.total = static_cast<int>(particleCount);
+    cullCounts.culled = static_cast<int>(particleCount - visibleParticles.size());
+    if (visibleParticles.empty()) return;
+
+    // Billboarding, fade and shrink happen in the vertex shader
+    FrameVector<TrailInstance> instances(visibleParticles.size());
+    for (size_t i = 0; i < visibleParticles.size(); i++) {
+        const TrailParticle& particle = trailParticles[visibleParticles[i]];
+        instances[i].position = particle.position;
+        instances[i].scale = particle.scale;
+        instances[i].color = particle.color;
+        instances[i].age = particle.duration - particle.timer;
+        instances[i].duration = particle.duration;
+    }
+    const size_t offset = streamBuffer.write(instances.data(), instances.size() * sizeof(TrailInstance));
+
+    DrawPacket packet;
+    packet.program = &trailShaderProgram;
+    packet.vertexArray = trailVAO;
+    packet.texture = trailTexture;
+    packet.indexType = GL_UNSIGNED_INT;
+    packet.indexCount = static_cast<GLsizei>(trailIndices.size());
+    packet.instanceCount = static_cast<GLsizei>(instances.size());
+    packet.setup = setupTrailDraw;
+    packet.data = queue.keep(offset);
+    queue.submit(RENDER_PASS_TRANSPARENT, LAYER_TRAILS, 0.0f, packet);
+}
+
+// Generate an icosphere: an icosahedron whose triangles are split into four, subdivisions
+// times over. Same vertex layout as generateSphere, for small objects where a UV sphere
+// wastes triangles.
+void generateIcosphere(float radius, int subdivisions, std::vector<float>& vertices, std::vector<unsigned int>& indices) {
+    const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+    std::vector<glm::vec3> points = {
+        glm::vec3(-1, t, 0), glm::vec3(1, t, 0), glm::vec3(-1, -t, 0), glm::vec3(1, -t, 0),
+        glm::vec3(0, -1, t), glm::vec3(0, 1, t), glm::vec3(0, -1, -t), glm::vec3(0, 1, -t),
+        glm::vec3(t, 0, -1), glm::vec3(t, 0, 1), glm::vec3(-t, 0, -1), glm::vec3(-t, 0, 1)
+    };
+    std::vector<unsigned int> triangles = {
+        0, 11, 5,   0, 5, 1,   0, 1, 7,   0, 7, 10,  0, 10, 11,
+        1, 5, 9,    5, 11, 4,  11, 10, 2, 10, 7, 6,  7, 1, 8,
+        3, 9, 4,    3, 4, 2,   3, 2, 6,   3, 6, 8,   3, 8, 9,
+        4, 9, 5,    2, 4, 11,  6, 2, 10,  8, 6, 7,   9, 8, 1
+    };
+
+    for (int level = 0; level < subdivisions; level++) {
+        // Edge midpoints are shared between neighbouring triangles
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> midpoints;
+        auto midpoint = [&](unsigned int a, unsigned int b) {
+            std::pair<unsigned int, unsigned int> edge(std::min(a, b), std::max(a, b));
+            auto found = midpoints.find(edge);
+            if (found != midpoints.end()) return found->second;
+            points.push_back((points[a] + points[b]) * 0.5f);
+            unsigned int index = static_cast<unsigned int>(points.size() - 1);
+            midpoints[edge] = index;
+            return index;
+        };
+
+        std::vector<unsigned int> subdivided;
+        for (size_t i = 0; i < triangles.size(); i += 3) {
+            unsigned int a = triangles[i], b = triangles[i + 1], c = triangles[i + 2];
+            unsigned int ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+            subdivided.insert(subdivided.end(), { a, ab, ca,  b, bc, ab,  c, ca, bc,  ab, bc, ca });
+        }
+        triangles.swap(subdivided);
     }
 
-    // Restore state
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-    glUseProgram(last_program);
+    vertices.clear();
+    for (const glm::vec3& point : points) {
+        glm::vec3 normal = glm::normalize(point);
+        glm::vec3 position = normal * radius;
+        vertices.insert(vertices.end(), { position.x, position.y, position.z, normal.x, normal.y, normal.z });
+    }
+    indices = triangles;
 }
 
 // Function to generate sphere vertices and indices
@@ -2637,10 +2430,64 @@ void generateSphere(float radius, int sectors, int stacks, std::vector<float>& v
     }
 }
 
+// Sphere levels of detail, finest first. Each level is the base tessellation scaled down by
+// SPHERE_LOD_DETAIL and lives in the shared static geometry.
+const int SPHERE_LOD_COUNT = 4;
+const float SPHERE_LOD_DETAIL[SPHERE_LOD_COUNT] = { 1.0f, 0.67f, 0.45f, 0.3f };
+const float SPHERE_LOD_ERROR_PIXELS = 0.5f; // Largest silhouette error a level may show on screen
+const float SPHERE_LOD_HYSTERESIS = 0.2f;   // How far past a switch point a sphere must go to switch back
+
+struct SphereLodChain {
+    MeshRange levels[SPHERE_LOD_COUNT];
+    float maxPixels[SPHERE_LOD_COUNT]; // Largest projected radius each level is accurate enough for
+};
+
+// What the last frame drew, for the F1 window
+struct RenderStats {
+    int playerLod = 0;
+    int eggsPerLod[SPHERE_LOD_COUNT] = {};
+    CullCounts eggs, trails, crosses, particles;
+    RenderQueueStats queue;
+};
+
+RenderStats renderStats;
+
+// Add every level of a sphere to the static geometry
+void createSphereLodChain(SphereLodChain& chain, StaticGeometry& geometry, float radius, int sectors, int stacks) {
+    const float PI = 3.14159265359f;
+
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+
+    for (int level = 0; level < SPHERE_LOD_COUNT; level++) {
+        int levelSectors = std::max(6, static_cast<int>(std::lround(sectors * SPHERE_LOD_DETAIL[level])));
+        int levelStacks = std::max(3, static_cast<int>(std::lround(stacks * SPHERE_LOD_DETAIL[level])));
+        generateSphere(radius, levelSectors, levelStacks, vertices, indices);
+
+        // A chord of a circle cut into n segments falls short of the circle by r * (1 - cos(pi / n))
+        chain.maxPixels[level] = SPHERE_LOD_ERROR_PIXELS / (1.0f - std::cos(PI / levelSectors));
+        chain.levels[level] = geometry.add(vertices, indices);
+    }
+}
+
+// Pick the coarsest level that still looks right at the given projected radius (in pixels).
+// A sphere only drops to a coarser level once it is clearly below that level's limit, and
+// keeps its level until clearly above it, so one hovering near a limit doesn't flicker.
+int selectSphereLod(const SphereLodChain& chain, float projectedPixels, int currentLod) {
+    for (int level = SPHERE_LOD_COUNT - 1; level > 0; level--) {
+        float limit = chain.maxPixels[level] * (currentLod >= level ? 1.0f + SPHERE_LOD_HYSTERESIS : 1.0f - SPHERE_LOD_HYSTERESIS);
+        if (projectedPixels <= limit) return level;
+    }
+    return 0;
+}
+
+// Finest ground grid; (255 + 1)^2 vertices is the most 16-bit indices can address
+const int GROUND_MAX_DIVISIONS = 255;
+
 // Function to generate a simple ground plane with grid
 void generateGround(std::vector<float>& vertices, std::vector<unsigned int>& indices) {
     const float size = GROUND_SIZE;
-    const int divisions = 20;
+    const int divisions = glm::clamp(static_cast<int>(size), 20, GROUND_MAX_DIVISIONS); // About one unit per cell
     const float step = size / divisions;
 
     vertices.clear();
@@ -2719,18 +2566,16 @@ void generateCross(std::vector<float>& vertices, std::vector<unsigned int>& indi
 // Initialize text rendering with FreeType
 void initTextRendering() {
     // Compile and setup the shader
-    textShaderProgram = createShaderProgram(textVertexShaderSource, textFragmentShaderSource);
+    textShaderProgram.create(textVertexShaderSource, textFragmentShaderSource);
 
-    // Configure VAO/VBO for texture quads
+    // Configure VAO for texture quads, which are written to the stream buffer
     glGenVertexArrays(1, &textVAO);
-    glGenBuffers(1, &textVBO);
-    glBindVertexArray(textVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, textVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    glState.bindVertexArray(textVAO);
+    glState.bindArrayBuffer(streamBuffer.id());
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    glState.bindArrayBuffer(0);
+    glState.bindVertexArray(0);
 
     // FreeType
     FT_Library ft;
@@ -2760,7 +2605,7 @@ void initTextRendering() {
         // Generate texture
         unsigned int texture;
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        glState.bindTexture2D(texture);
         glTexImage2D(
             GL_TEXTURE_2D,
             0,
@@ -2789,386 +2634,245 @@ void initTextRendering() {
         Characters.insert(std::pair<char, Character>(c, character));
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    glState.bindTexture2D(0);
 
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
 
     // Configure shader
-    glUseProgram(textShaderProgram);
+    textShaderProgram.use();
     glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(SCR_WIDTH), 0.0f, static_cast<float>(SCR_HEIGHT));
-    glUniformMatrix4fv(glGetUniformLocation(textShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    textShaderProgram.setMat4("projection", projection);
+}
+
+// Width of a line of text in pixels at the given scale
+float TextWidth(const char* text, float scale) {
+    float width = 0.0f;
+    for (const char* c = text; *c; c++) {
+        width += (Characters[*c].Advance >> 6) * scale;
+    }
+    return width;
 }
 
 // Render text function
-void RenderText(std::string text, float x, float y, float scale, glm::vec3 color) {
+void RenderText(const char* text, float x, float y, float scale, glm::vec3 color) {
     // Save current state
-    GLint last_program;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
-    GLint last_texture;
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
-    GLint last_array_buffer;
-    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
-    GLint last_vertex_array;
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
+    GLuint last_program = glState.program();
+    GLuint last_texture = glState.texture2D();
+    GLuint last_array_buffer = glState.arrayBuffer();
+    GLuint last_vertex_array = glState.vertexArray();
 
     // Enable blending for text
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setBlend(true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Activate corresponding render state
-    glUseProgram(textShaderProgram);
-    glUniform3f(glGetUniformLocation(textShaderProgram, "textColor"), color.x, color.y, color.z);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(textVAO);
-
-    // Iterate through all characters
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        Character ch = Characters[*c];
-
-        float xpos = x + ch.Bearing.x * scale;
-        float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-        float w = ch.Size.x * scale;
-        float h = ch.Size.y * scale;
-
-        // Update VBO for each character
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   0.0f, 0.0f },
-            { xpos,     ypos,       0.0f, 1.0f },
-            { xpos + w, ypos,       1.0f, 1.0f },
-
-            { xpos,     ypos + h,   0.0f, 0.0f },
-            { xpos + w, ypos,       1.0f, 1.0f },
-            { xpos + w, ypos + h,   1.0f, 0.0f }
-        };
-
-        // Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-
-        // Update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, textVBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        // Render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    textShaderProgram.use();
+    textShaderProgram.setVec3("textColor", color);
+    glState.activeTexture(GL_TEXTURE0);
+    glState.bindVertexArray(textVAO);
+
+    // Build the quads for the whole string
+    const size_t length = strlen(text);
+    if (length > 0) {
+        FrameVector<glm::vec4> vertices;
+        vertices.reserve(length * 6);
+        for (const char* c = text; *c; c++) {
+            const Character& ch = Characters[*c];
+
+            float xpos = x + ch.Bearing.x * scale;
+            float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+
+            float w = ch.Size.x * scale;
+            float h = ch.Size.y * scale;
+
+            vertices.push_back(glm::vec4(xpos,     ypos + h,   0.0f, 0.0f));
+            vertices.push_back(glm::vec4(xpos,     ypos,       0.0f, 1.0f));
+            vertices.push_back(glm::vec4(xpos + w, ypos,       1.0f, 1.0f));
+
+            vertices.push_back(glm::vec4(xpos,     ypos + h,   0.0f, 0.0f));
+            vertices.push_back(glm::vec4(xpos + w, ypos,       1.0f, 1.0f));
+            vertices.push_back(glm::vec4(xpos + w, ypos + h,   1.0f, 0.0f));
+
+            // Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
+            x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
+        }
 
-        // Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-        x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
+        // Upload them once, then render each glyph texture over its quad
+        const size_t offset = streamBuffer.write(vertices.data(), vertices.size() * sizeof(glm::vec4), sizeof(glm::vec4));
+        GLint first = static_cast<GLint>(offset / sizeof(glm::vec4));
+        for (const char* c = text; *c; c++, first += 6) {
+            glState.bindTexture2D(Characters[*c].TextureID);
+            glDrawArrays(GL_TRIANGLES, first, 6);
+        }
     }
 
     // Restore state
-    glBindVertexArray(last_vertex_array);
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-    glUseProgram(last_program);
+    glState.bindVertexArray(last_vertex_array);
+    glState.bindArrayBuffer(last_array_buffer);
+    glState.bindTexture2D(last_texture);
+    glState.useProgram(last_program);
 
-    glDisable(GL_BLEND);
+    glState.setBlend(false);
+}
+
+// Tint the whole screen
+void drawScreenOverlay(const glm::vec4& color) {
+    overlayShaderProgram.use();
+    overlayShaderProgram.setVec4("overlayColor", color);
+    glState.bindVertexArray(postprocessVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
 // Render high score input dialog
 void renderHighScoreInput() {
     if (!showHighScoreInput) return;
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setBlend(true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Semi-transparent background
-    glDisable(GL_DEPTH_TEST);
-
-    float vertices[] = {
-        0.0f, 0.0f, 0.0f, 0.0f,
-        SCR_WIDTH, 0.0f, 1.0f, 0.0f,
-        SCR_WIDTH, SCR_HEIGHT, 1.0f, 1.0f,
-        0.0f, SCR_HEIGHT, 0.0f, 1.0f
-    };
-    unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
-
-    unsigned int tempVAO, tempVBO, tempEBO;
-    glGenVertexArrays(1, &tempVAO);
-    glGenBuffers(1, &tempVBO);
-    glGenBuffers(1, &tempEBO);
-
-    glBindVertexArray(tempVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, tempVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tempEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    unsigned int overlayShader = createShaderProgram(
-        "#version 330 core\n"
-        "layout (location = 0) in vec4 aPos;\n"
-        "void main() { gl_Position = vec4(aPos.xy * 2.0 - 1.0, 0.0, 1.0); }",
-        "#version 330 core\n"
-        "out vec4 FragColor;\n"
-        "void main() { FragColor = vec4(0.0, 0.0, 0.0, 0.8); }"
-    );
-
-    glUseProgram(overlayShader);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    glState.setDepthTest(false);
 
-    glDeleteProgram(overlayShader);
-    glDeleteVertexArrays(1, &tempVAO);
-    glDeleteBuffers(1, &tempVBO);
-    glDeleteBuffers(1, &tempEBO);
+    drawScreenOverlay(glm::vec4(0.0f, 0.0f, 0.0f, 0.8f));
 
-    glEnable(GL_DEPTH_TEST);
+    glState.setDepthTest(true);
 
     // New high score text
-    std::string newHighScoreText = "NEW HIGH SCORE!";
-    float newWidth = 0;
-    for (char c : newHighScoreText) {
-        Character ch = Characters[c];
-        newWidth += (ch.Advance >> 6) * 0.8f;
-    }
+    const char* newHighScoreText = "NEW HIGH SCORE!";
+    float newWidth = TextWidth(newHighScoreText, 0.8f);
     float newX = (SCR_WIDTH - newWidth) / 2.0f;
     RenderText(newHighScoreText, newX, SCR_HEIGHT * 0.7f, 0.8f, glm::vec3(1.0f, 1.0f, 0.0f));
 
     // Score text
-    std::string scoreText = "Score: " + std::to_string(score);
-    float scoreWidth = 0;
-    for (char c : scoreText) {
-        Character ch = Characters[c];
-        scoreWidth += (ch.Advance >> 6) * 0.5f;
-    }
+    const char* scoreText = frameFormat("Score: %d", score);
+    float scoreWidth = TextWidth(scoreText, 0.5f);
     float scoreX = (SCR_WIDTH - scoreWidth) / 2.0f;
     RenderText(scoreText, scoreX, SCR_HEIGHT * 0.6f, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f));
 
     // Enter name prompt
-    std::string namePrompt = "Enter your name:";
-    float promptWidth = 0;
-    for (char c : namePrompt) {
-        Character ch = Characters[c];
-        promptWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    const char* namePrompt = "Enter your name:";
+    float promptWidth = TextWidth(namePrompt, 0.4f);
     float promptX = (SCR_WIDTH - promptWidth) / 2.0f;
     RenderText(namePrompt, promptX, SCR_HEIGHT * 0.5f, 0.4f, glm::vec3(0.7f, 0.7f, 1.0f));
 
     // Player name input (display only)
-    std::string displayName = playerNameInput + "_";
     // Blinking cursor effect
-    if (static_cast<int>(glfwGetTime() * 2) % 2 == 0) {
-        displayName = playerNameInput + "_";
-    }
-    else {
-        displayName = playerNameInput + " ";
-    }
+    bool cursorVisible = static_cast<int>(glfwGetTime() * 2) % 2 == 0;
+    const char* displayName = frameFormat("%s%c", playerNameInput.c_str(), cursorVisible ? '_' : ' ');
 
-    float nameWidth = 0;
-    for (char c : displayName) {
-        Character ch = Characters[c];
-        nameWidth += (ch.Advance >> 6) * 0.5f;
-    }
+    float nameWidth = TextWidth(displayName, 0.5f);
     float nameX = (SCR_WIDTH - nameWidth) / 2.0f;
     RenderText(displayName, nameX, SCR_HEIGHT * 0.45f, 0.5f, glm::vec3(1.0f, 0.8f, 0.2f));
 
     // Instructions
-    std::string instruction1 = "Press ENTER to submit";
-    float inst1Width = 0;
-    for (char c : instruction1) {
-        Character ch = Characters[c];
-        inst1Width += (ch.Advance >> 6) * 0.3f;
-    }
+    const char* instruction1 = "Press ENTER to submit";
+    float inst1Width = TextWidth(instruction1, 0.3f);
     float inst1X = (SCR_WIDTH - inst1Width) / 2.0f;
     RenderText(instruction1, inst1X, SCR_HEIGHT * 0.35f, 0.3f, glm::vec3(0.7f, 0.7f, 0.7f));
 
-    std::string instruction2 = "Press BACKSPACE to delete, ESC to cancel";
-    float inst2Width = 0;
-    for (char c : instruction2) {
-        Character ch = Characters[c];
-        inst2Width += (ch.Advance >> 6) * 0.25f;
-    }
+    const char* instruction2 = "Press BACKSPACE to delete, ESC to cancel";
+    float inst2Width = TextWidth(instruction2, 0.25f);
     float inst2X = (SCR_WIDTH - inst2Width) / 2.0f;
     RenderText(instruction2, inst2X, SCR_HEIGHT * 0.32f, 0.25f, glm::vec3(0.7f, 0.7f, 0.7f));
 
-    glDisable(GL_BLEND);
+    glState.setBlend(false);
 }
 
 // Render Start Screen
 void renderStartScreen() {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setBlend(true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Title
-    std::string titleText = "EGG COLLECTOR";
-    float titleWidth = 0;
-    for (char c : titleText) {
-        Character ch = Characters[c];
-        titleWidth += (ch.Advance >> 6) * 1.0f;
-    }
+    const char* titleText = "EGG COLLECTOR";
+    float titleWidth = TextWidth(titleText, 1.0f);
     float titleX = (SCR_WIDTH - titleWidth) / 2.0f;
     RenderText(titleText, titleX, SCR_HEIGHT * 0.7f, 1.0f, glm::vec3(1.0f, 1.0f, 0.0f));
 
     // Subtitle
-    std::string subtitleText = "Fruit Ninja Style!";
-    float subtitleWidth = 0;
-    for (char c : subtitleText) {
-        Character ch = Characters[c];
-        subtitleWidth += (ch.Advance >> 6) * 0.5f;
-    }
+    const char* subtitleText = "Fruit Ninja Style!";
+    float subtitleWidth = TextWidth(subtitleText, 0.5f);
     float subtitleX = (SCR_WIDTH - subtitleWidth) / 2.0f;
     RenderText(subtitleText, subtitleX, SCR_HEIGHT * 0.6f, 0.5f, glm::vec3(1.0f, 0.5f, 0.0f));
 
     // High score display
-    std::string highScoreText = "High Score: " + std::to_string(highScore);
-    float highScoreWidth = 0;
-    for (char c : highScoreText) {
-        Character ch = Characters[c];
-        highScoreWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    const char* highScoreText = frameFormat("High Score: %d", highScore);
+    float highScoreWidth = TextWidth(highScoreText, 0.4f);
     float highScoreX = (SCR_WIDTH - highScoreWidth) / 2.0f;
     RenderText(highScoreText, highScoreX, SCR_HEIGHT * 0.5f, 0.4f, glm::vec3(0.0f, 1.0f, 1.0f));
 
     // Instructions
-    std::string instruction1 = "Collect colorful eggs, avoid purple poison eggs!";
-    float inst1Width = 0;
-    for (char c : instruction1) {
-        Character ch = Characters[c];
-        inst1Width += (ch.Advance >> 6) * 0.3f;
-    }
+    const char* instruction1 = "Collect colorful eggs, avoid purple poison eggs!";
+    float inst1Width = TextWidth(instruction1, 0.3f);
     float inst1X = (SCR_WIDTH - inst1Width) / 2.0f;
     RenderText(instruction1, inst1X, SCR_HEIGHT * 0.4f, 0.3f, glm::vec3(0.8f, 0.8f, 0.8f));
 
-    std::string instruction2 = "You can only miss " + std::to_string(MAX_MISSES) + " eggs total!";
-    float inst2Width = 0;
-    for (char c : instruction2) {
-        Character ch = Characters[c];
-        inst2Width += (ch.Advance >> 6) * 0.3f;
-    }
+    const char* instruction2 = frameFormat("You can only miss %d eggs total!", MAX_MISSES);
+    float inst2Width = TextWidth(instruction2, 0.3f);
     float inst2X = (SCR_WIDTH - inst2Width) / 2.0f;
     RenderText(instruction2, inst2X, SCR_HEIGHT * 0.37f, 0.3f, glm::vec3(0.8f, 0.8f, 0.8f));
 
     // Controls
-    std::string controlsTitle = "CONTROLS:";
-    float ctrlTitleWidth = 0;
-    for (char c : controlsTitle) {
-        Character ch = Characters[c];
-        ctrlTitleWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    const char* controlsTitle = "CONTROLS:";
+    float ctrlTitleWidth = TextWidth(controlsTitle, 0.4f);
     float ctrlTitleX = (SCR_WIDTH - ctrlTitleWidth) / 2.0f;
     RenderText(controlsTitle, ctrlTitleX, SCR_HEIGHT * 0.3f, 0.4f, glm::vec3(0.3f, 0.8f, 1.0f));
 
-    std::string controls1 = "WASD: Move   |   Mouse: Look   |   Scroll: Zoom";
-    float ctrl1Width = 0;
-    for (char c : controls1) {
-        Character ch = Characters[c];
-        ctrl1Width += (ch.Advance >> 6) * 0.25f;
-    }
+    const char* controls1 = "WASD: Move   |   Mouse: Look   |   Scroll: Zoom";
+    float ctrl1Width = TextWidth(controls1, 0.25f);
     float ctrl1X = (SCR_WIDTH - ctrl1Width) / 2.0f;
     RenderText(controls1, ctrl1X, SCR_HEIGHT * 0.27f, 0.25f, glm::vec3(0.7f, 0.7f, 0.7f));
 
-    std::string controls2 = "P: Pause   |   R: Restart   |   F1: Settings   |   ESC: Quit";
-    float ctrl2Width = 0;
-    for (char c : controls2) {
-        Character ch = Characters[c];
-        ctrl2Width += (ch.Advance >> 6) * 0.25f;
-    }
+    const char* controls2 = "P: Pause   |   R: Restart   |   F1: Settings   |   ESC: Quit";
+    float ctrl2Width = TextWidth(controls2, 0.25f);
     float ctrl2X = (SCR_WIDTH - ctrl2Width) / 2.0f;
     RenderText(controls2, ctrl2X, SCR_HEIGHT * 0.24f, 0.25f, glm::vec3(0.7f, 0.7f, 0.7f));
 
     // Start prompt
-    std::string startText = "Press ENTER or SPACE to Start";
-    float startWidth = 0;
-    for (char c : startText) {
-        Character ch = Characters[c];
-        startWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    const char* startText = "Press ENTER or SPACE to Start";
+    float startWidth = TextWidth(startText, 0.4f);
     float startX = (SCR_WIDTH - startWidth) / 2.0f;
 
     // Blinking effect
     float blink = sin(glfwGetTime() * 3.0f) * 0.5f + 0.5f;
     RenderText(startText, startX, SCR_HEIGHT * 0.1f, 0.4f, glm::vec3(0.0f, 1.0f, 0.0f) * blink);
 
-    glDisable(GL_BLEND);
+    glState.setBlend(false);
 }
 
 // Render Pause Screen
 void renderPauseScreen() {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setBlend(true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Semi-transparent background
-    glDisable(GL_DEPTH_TEST);
-    glUseProgram(textShaderProgram);
-    glBindVertexArray(textVAO);
+    glState.setDepthTest(false);
 
     // Draw a semi-transparent quad over the entire screen
-    float vertices[] = {
-        0.0f, 0.0f, 0.0f, 0.0f,
-        SCR_WIDTH, 0.0f, 1.0f, 0.0f,
-        SCR_WIDTH, SCR_HEIGHT, 1.0f, 1.0f,
-        0.0f, SCR_HEIGHT, 0.0f, 1.0f
-    };
-    unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
-
-    unsigned int tempVAO, tempVBO, tempEBO;
-    glGenVertexArrays(1, &tempVAO);
-    glGenBuffers(1, &tempVBO);
-    glGenBuffers(1, &tempEBO);
-
-    glBindVertexArray(tempVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, tempVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tempEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Use a simple shader for the overlay
-    unsigned int overlayShader = createShaderProgram(
-        "#version 330 core\n"
-        "layout (location = 0) in vec4 aPos;\n"
-        "void main() { gl_Position = vec4(aPos.xy * 2.0 - 1.0, 0.0, 1.0); }",
-        "#version 330 core\n"
-        "out vec4 FragColor;\n"
-        "void main() { FragColor = vec4(0.0, 0.0, 0.0, 0.7); }"
-    );
-
-    glUseProgram(overlayShader);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    drawScreenOverlay(glm::vec4(0.0f, 0.0f, 0.0f, 0.7f));
 
-    glDeleteProgram(overlayShader);
-    glDeleteVertexArrays(1, &tempVAO);
-    glDeleteBuffers(1, &tempVBO);
-    glDeleteBuffers(1, &tempEBO);
-
-    glEnable(GL_DEPTH_TEST);
+    glState.setDepthTest(true);
 
     // Pause text
-    std::string pauseText = "GAME PAUSED";
-    float pauseWidth = 0;
-    for (char c : pauseText) {
-        Character ch = Characters[c];
-        pauseWidth += (ch.Advance >> 6) * 0.8f;
-    }
+    const char* pauseText = "GAME PAUSED";
+    float pauseWidth = TextWidth(pauseText, 0.8f);
     float pauseX = (SCR_WIDTH - pauseWidth) / 2.0f;
     RenderText(pauseText, pauseX, SCR_HEIGHT * 0.6f, 0.8f, glm::vec3(1.0f, 1.0f, 0.0f));
 
     // Continue prompt
-    std::string continueText = "Press P to Continue";
-    float continueWidth = 0;
-    for (char c : continueText) {
-        Character ch = Characters[c];
-        continueWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    const char* continueText = "Press P to Continue";
+    float continueWidth = TextWidth(continueText, 0.4f);
     float continueX = (SCR_WIDTH - continueWidth) / 2.0f;
     RenderText(continueText, continueX, SCR_HEIGHT * 0.4f, 0.4f, glm::vec3(1.0f, 1.0f, 1.0f));
 
     // Restart prompt
-    std::string restartText = "Press R to Restart";
-    float restartWidth = 0;
-    for (char c : restartText) {
-        Character ch = Characters[c];
-        restartWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    const char* restartText = "Press R to Restart";
+    float restartWidth = TextWidth(restartText, 0.4f);
     float restartX = (SCR_WIDTH - restartWidth) / 2.0f;
     RenderText(restartText, restartX, SCR_HEIGHT * 0.35f, 0.4f, glm::vec3(1.0f, 1.0f, 1.0f));
 
-    glDisable(GL_BLEND);
+    glState.setBlend(false);
 }
 
 // Render Game Over Screen
@@ -3178,119 +2882,56 @@ void renderGameOverScreen() {
         return;
     }
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setBlend(true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Semi-transparent background (same as pause screen)
-    glDisable(GL_DEPTH_TEST);
-    glUseProgram(textShaderProgram);
-    glBindVertexArray(textVAO);
-
-    float vertices[] = {
-        0.0f, 0.0f, 0.0f, 0.0f,
-        SCR_WIDTH, 0.0f, 1.0f, 0.0f,
-        SCR_WIDTH, SCR_HEIGHT, 1.0f, 1.0f,
-        0.0f, SCR_HEIGHT, 0.0f, 1.0f
-    };
-    unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
-
-    unsigned int tempVAO, tempVBO, tempEBO;
-    glGenVertexArrays(1, &tempVAO);
-    glGenBuffers(1, &tempVBO);
-    glGenBuffers(1, &tempEBO);
-
-    glBindVertexArray(tempVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, tempVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tempEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    unsigned int overlayShader = createShaderProgram(
-        "#version 330 core\n"
-        "layout (location = 0) in vec4 aPos;\n"
-        "void main() { gl_Position = vec4(aPos.xy * 2.0 - 1.0, 0.0, 1.0); }",
-        "#version 330 core\n"
-        "out vec4 FragColor;\n"
-        "void main() { FragColor = vec4(0.2, 0.0, 0.0, 0.8); }"
-    );
+    glState.setDepthTest(false);
+    drawScreenOverlay(glm::vec4(0.2f, 0.0f, 0.0f, 0.8f));
 
-    glUseProgram(overlayShader);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-
-    glDeleteProgram(overlayShader);
-    glDeleteVertexArrays(1, &tempVAO);
-    glDeleteBuffers(1, &tempVBO);
-    glDeleteBuffers(1, &tempEBO);
-
-    glEnable(GL_DEPTH_TEST);
+    glState.setDepthTest(true);
 
     // Game Over text
-    std::string gameOverText = "GAME OVER";
-    float gameOverWidth = 0;
-    for (char c : gameOverText) {
-        Character ch = Characters[c];
-        gameOverWidth += (ch.Advance >> 6) * 1.0f;
-    }
+    const char* gameOverText = "GAME OVER";
+    float gameOverWidth = TextWidth(gameOverText, 1.0f);
     float gameOverX = (SCR_WIDTH - gameOverWidth) / 2.0f;
     RenderText(gameOverText, gameOverX, SCR_HEIGHT * 0.8f, 1.0f, glm::vec3(1.0f, 0.0f, 0.0f));
 
     // Final score
-    std::string scoreText = "Final Score: " + std::to_string(score);
-    float scoreWidth = 0;
-    for (char c : scoreText) {
-        Character ch = Characters[c];
-        scoreWidth += (ch.Advance >> 6) * 0.5f;
-    }
+    const char* scoreText = frameFormat("Final Score: %d", score);
+    float scoreWidth = TextWidth(scoreText, 0.5f);
     float scoreX = (SCR_WIDTH - scoreWidth) / 2.0f;
     RenderText(scoreText, scoreX, SCR_HEIGHT * 0.7f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
 
     // High score
-    std::string highScoreText = "High Score: " + std::to_string(highScore);
-    float highScoreWidth = 0;
-    for (char c : highScoreText) {
-        Character ch = Characters[c];
-        highScoreWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    const char* highScoreText = frameFormat("High Score: %d", highScore);
+    float highScoreWidth = TextWidth(highScoreText, 0.4f);
     float highScoreX = (SCR_WIDTH - highScoreWidth) / 2.0f;
     RenderText(highScoreText, highScoreX, SCR_HEIGHT * 0.65f, 0.4f, glm::vec3(0.0f, 1.0f, 1.0f));
 
     // Game over reason
-    std::string reasonText;
+    const char* reasonText;
     if (missedEggs >= MAX_MISSES) {
         reasonText = "Too many missed eggs!";
     }
     else {
         reasonText = "No lives remaining!";
     }
-    float reasonWidth = 0;
-    for (char c : reasonText) {
-        Character ch = Characters[c];
-        reasonWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    float reasonWidth = TextWidth(reasonText, 0.4f);
     float reasonX = (SCR_WIDTH - reasonWidth) / 2.0f;
     RenderText(reasonText, reasonX, SCR_HEIGHT * 0.55f, 0.4f, glm::vec3(1.0f, 0.5f, 0.5f));
 
     // Top 3 high scores
     if (!highScores.empty()) {
-        std::string highScoresTitle = "TOP SCORES:";
-        float titleWidth = 0;
-        for (char c : highScoresTitle) {
-            Character ch = Characters[c];
-            titleWidth += (ch.Advance >> 6) * 0.4f;
-        }
+        const char* highScoresTitle = "TOP SCORES:";
+        float titleWidth = TextWidth(highScoresTitle, 0.4f);
         float titleX = (SCR_WIDTH - titleWidth) / 2.0f;
         RenderText(highScoresTitle, titleX, SCR_HEIGHT * 0.45f, 0.4f, glm::vec3(0.3f, 0.8f, 1.0f));
 
         // Display top 3 scores
         for (int i = 0; i < std::min(3, (int)highScores.size()); i++) {
-            std::string scoreEntry = std::to_string(i + 1) + ". " + highScores[i].playerName + " - " + std::to_string(highScores[i].score);
-            float entryWidth = 0;
-            for (char c : scoreEntry) {
-                Character ch = Characters[c];
-                entryWidth += (ch.Advance >> 6) * 0.3f;
-            }
+            const char* scoreEntry = frameFormat("%d. %s - %d", i + 1, highScores[i].playerName.c_str(), highScores[i].score);
+            float entryWidth = TextWidth(scoreEntry, 0.3f);
             float entryX = (SCR_WIDTH - entryWidth) / 2.0f;
             float yPos = SCR_HEIGHT * 0.4f - i * 30.0f;
 
@@ -3303,12 +2944,8 @@ void renderGameOverScreen() {
     }
 
     // Restart prompt
-    std::string restartText = "Press R to Play Again";
-    float restartWidth = 0;
-    for (char c : restartText) {
-        Character ch = Characters[c];
-        restartWidth += (ch.Advance >> 6) * 0.4f;
-    }
+    const char* restartText = "Press R to Play Again";
+    float restartWidth = TextWidth(restartText, 0.4f);
     float restartX = (SCR_WIDTH - restartWidth) / 2.0f;
     // Blinking effect
     float blink = sin(glfwGetTime() * 3.0f) * 0.5f + 0.5f;
@@ -3316,31 +2953,26 @@ void renderGameOverScreen() {
     RenderText(restartText, restartX, SCR_HEIGHT * 0.2f, 0.4f, glm::vec3(0.0f, 1.0f, 0.0f) * blink);
 
     // Return to menu prompt
-    std::string menuText = "Press ESC for Main Menu";
-    float menuWidth = 0;
-    for (char c : menuText) {
-        Character ch = Characters[c];
-        menuWidth += (ch.Advance >> 6) * 0.3f;
-    }
+    const char* menuText = "Press ESC for Main Menu";
+    float menuWidth = TextWidth(menuText, 0.3f);
     float menuX = (SCR_WIDTH - menuWidth) / 2.0f;
     RenderText(menuText, menuX, SCR_HEIGHT * 0.15f, 0.3f, glm::vec3(0.7f, 0.7f, 0.7f));
 
-    glDisable(GL_BLEND);
+    glState.setBlend(false);
 }
 
 // Render a miss cross in the HUD - BIG X-SHAPED VERSION
 void renderMissCrossHUD(float x, float y, float size, glm::vec3 color) {
     // Save current state
-    GLint last_program, last_texture, last_array_buffer, last_vertex_array;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
-    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
+    GLuint last_program = glState.program();
+    GLuint last_texture = glState.texture2D();
+    GLuint last_array_buffer = glState.arrayBuffer();
+    GLuint last_vertex_array = glState.vertexArray();
 
     // Enable blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST);
+    glState.setBlend(true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setDepthTest(false);
 
     // Create a simple shader for HUD elements
     const char* hudVertexShaderSource = R"(
@@ -3362,12 +2994,12 @@ void renderMissCrossHUD(float x, float y, float size, glm::vec3 color) {
         }
     )";
 
-    static unsigned int hudShaderProgram = 0;
+    static ShaderProgram hudShaderProgram;
     static unsigned int crossVAO = 0, crossVBO = 0;
 
     // Initialize shader and buffers if not already done
-    if (hudShaderProgram == 0) {
-        hudShaderProgram = createShaderProgram(hudVertexShaderSource, hudFragmentShaderSource);
+    if (hudShaderProgram.id() == 0) {
+        hudShaderProgram.create(hudVertexShaderSource, hudFragmentShaderSource);
 
         // Create X-shaped cross geometry with LARGER coordinates
         float crossVertices[] = {
@@ -3383,45 +3015,45 @@ void renderMissCrossHUD(float x, float y, float size, glm::vec3 color) {
         glGenVertexArrays(1, &crossVAO);
         glGenBuffers(1, &crossVBO);
 
-        glBindVertexArray(crossVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, crossVBO);
+        glState.bindVertexArray(crossVAO);
+        glState.bindArrayBuffer(crossVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(crossVertices), crossVertices, GL_STATIC_DRAW);
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
-        glBindVertexArray(0);
+        glState.bindVertexArray(0);
     }
 
     // Use HUD shader
-    glUseProgram(hudShaderProgram);
+    hudShaderProgram.use();
 
     // Set up orthographic projection
     glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(SCR_WIDTH), 0.0f, static_cast<float>(SCR_HEIGHT));
-    glUniformMatrix4fv(glGetUniformLocation(hudShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniform3f(glGetUniformLocation(hudShaderProgram, "crossColor"), color.x, color.y, color.z);
+    hudShaderProgram.setMat4("projection", projection);
+    hudShaderProgram.setVec3("crossColor", color);
 
     // Calculate transformation for the cross
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(x, y, 0.0f));
     model = glm::scale(model, glm::vec3(size, size, 1.0f));
-    glUniformMatrix4fv(glGetUniformLocation(hudShaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    hudShaderProgram.setMat4("model", model);
 
     // Set THICKER line width for bolder X
     glLineWidth(6.0f); // INCREASED from 3.0f to 6.0f
 
     // Draw the X-shaped cross (two diagonal lines)
-    glBindVertexArray(crossVAO);
+    glState.bindVertexArray(crossVAO);
     glDrawArrays(GL_LINES, 0, 4); // 4 vertices = 2 lines
 
     // Reset line width
     glLineWidth(1.0f);
 
     // Restore state
-    glBindVertexArray(last_vertex_array);
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-    glUseProgram(last_program);
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_BLEND);
+    glState.bindVertexArray(last_vertex_array);
+    glState.bindArrayBuffer(last_array_buffer);
+    glState.bindTexture2D(last_texture);
+    glState.useProgram(last_program);
+    glState.setDepthTest(true);
+    glState.setBlend(false);
 }
 
 // Render HUD function with egg icon and miss indicators
@@ -3430,23 +3062,23 @@ void renderHUD() {
     if (currentGameState != GAME_PLAYING) return;
 
     // Save current OpenGL state
-    GLboolean depth_test_enabled = glIsEnabled(GL_DEPTH_TEST);
-    glDisable(GL_DEPTH_TEST); // Disable depth test for 2D rendering
+    bool depth_test_enabled = glState.depthTest();
+    glState.setDepthTest(false); // Disable depth test for 2D rendering
 
     // Render egg icon and score
     float iconWidth = 50.0f;
     float iconHeight = 40.0f;
     RenderEggIcon(10.0f, SCR_HEIGHT - 50.0f, iconWidth, iconHeight, glm::vec3(1.0f, 1.0f, 1.0f));
 
-    std::string scoreText = " " + std::to_string(score);
+    const char* scoreText = frameFormat(" %d", score);
     RenderText(scoreText, iconWidth + 10.0f, SCR_HEIGHT - 40.0f, 0.5f, glm::vec3(1.0f, 1.0f, 0.0f));
 
     // Render high score in top-left below score
-    std::string highScoreText = "BEST: " + std::to_string(highScore);
+    const char* highScoreText = frameFormat("BEST: %d", highScore);
     RenderText(highScoreText, 15.0f, SCR_HEIGHT - 90.0f, 0.5f, glm::vec3(0.0f, 1.0f, 1.0f));
 
     // Render lives in top-left below high score
-    std::string livesText = "LIVES: " + std::to_string(lives);
+    const char* livesText = frameFormat("LIVES: %d", lives);
     glm::vec3 livesColor = (lives <= 1) ? glm::vec3(1.0f, 0.3f, 0.3f) : glm::vec3(0.3f, 1.0f, 0.3f);
     RenderText(livesText, 15.0f, SCR_HEIGHT - 130.0f, 0.5f, livesColor);
 
@@ -3474,23 +3106,19 @@ void renderHUD() {
 
     // Render respawn timer if player is dead but game isn't over
     if (!playerAlive && currentGameState == GAME_PLAYING) {
-        std::string respawnText = "RESPAWNING IN: " + std::to_string(static_cast<int>(playerRespawnTimer) + 1);
-        float textWidth = 0;
-        for (char c : respawnText) {
-            Character ch = Characters[c];
-            textWidth += (ch.Advance >> 6) * 0.5f;
-        }
+        const char* respawnText = frameFormat("RESPAWNING IN: %d", static_cast<int>(playerRespawnTimer) + 1);
+        float textWidth = TextWidth(respawnText, 0.5f);
         float x = (SCR_WIDTH - textWidth) / 2.0f;
         RenderText(respawnText, x, 100.0f, 0.5f, glm::vec3(1.0f, 0.5f, 0.0f));
     }
 
     // Render controls hint at bottom
-    std::string controlsText = "WASD: Move  |  Mouse: Look  |  Scroll: Zoom  |  P: Pause  |  F1: Settings  |  ESC: Quit";
+    const char* controlsText = "WASD: Move  |  Mouse: Look  |  Scroll: Zoom  |  P: Pause  |  F1: Settings  |  ESC: Quit";
     RenderText(controlsText, 25.0f, 30.0f, 0.3f, glm::vec3(0.7f, 0.7f, 0.7f));
 
     // Restore depth test state
     if (depth_test_enabled) {
-        glEnable(GL_DEPTH_TEST);
+        glState.setDepthTest(true);
     }
 }
 
@@ -3506,14 +3134,14 @@ void showCameraSettingsWindow() {
     ImGui::TextColored(ImVec4(1, 0, 0, 1), "MISSES: %d/%d", missedEggs, MAX_MISSES);
 
     // Game state
-    std::string stateText;
+    const char* stateText = "";
     switch (currentGameState) {
     case GAME_START: stateText = "START SCREEN"; break;
     case GAME_PLAYING: stateText = "PLAYING"; break;
     case GAME_PAUSED: stateText = "PAUSED"; break;
     case GAME_OVER: stateText = "GAME OVER"; break;
     }
-    ImGui::TextColored(ImVec4(0, 1, 1, 1), "STATE: %s", stateText.c_str());
+    ImGui::TextColored(ImVec4(0, 1, 1, 1), "STATE: %s", stateText);
 
     if (!playerAlive && currentGameState == GAME_PLAYING) {
         ImGui::TextColored(ImVec4(1, 0, 0, 1), "RESPAWNING IN: %.1f", playerRespawnTimer);
@@ -3586,12 +3214,12 @@ void showCameraSettingsWindow() {
 
         for (int i = 0; i < 3; i++) {
             ImGui::PushID(i);
-            if (ImGui::Button(("Save to Slot " + std::to_string(i + 1)).c_str())) {
+            if (ImGui::Button(frameFormat("Save to Slot %d", i + 1))) {
                 savedPositions[i] = playerPos;
                 std::cout << "Position saved to slot " << (i + 1) << std::endl;
             }
             ImGui::SameLine();
-            if (ImGui::Button(("Load Slot " + std::to_string(i + 1)).c_str())) {
+            if (ImGui::Button(frameFormat("Load Slot %d", i + 1))) {
                 playerTargetPos = savedPositions[i];
                 playerPos = savedPositions[i];
                 enforceWorldBoundaries(playerTargetPos);
@@ -3667,14 +3295,8 @@ void showCameraSettingsWindow() {
     }
 
     if (ImGui::CollapsingHeader("Egg System")) {
-        int regularEggCount = 0;
-        int poisonEggCount = 0;
-        for (const auto& egg : eggs) {
-            if (egg.active) {
-                if (egg.isPoison) poisonEggCount++;
-                else regularEggCount++;
-            }
-        }
+        int regularEggCount = eggs.regularCount();
+        int poisonEggCount = eggs.poisonCount();
 
         ImGui::Text("Regular Eggs: %d/%d", regularEggCount, MAX_EGGS);
         ImGui::Text("Poison Eggs: %d/%d", poisonEggCount, MAX_POISON_EGGS);
@@ -3702,26 +3324,27 @@ void showCameraSettingsWindow() {
 
         if (ImGui::SliderFloat("Poison Egg Chase Speed", &chaseSpeed, 1.0f, 8.0f)) {
             // Update all active poison eggs
-            for (auto& egg : eggs) {
-                if (egg.active && egg.isPoison) {
-                    egg.chaseSpeed = chaseSpeed;
+            for (size_t i = 0; i < eggs.size(); i++) {
+                if (eggs.isPoison(i)) {
+                    eggs.chaseSpeed[i] = chaseSpeed;
                 }
             }
         }
 
         if (ImGui::SliderFloat("Chase Start Delay", &chaseDelay, 0.0f, 3.0f)) {
             // Update all active poison eggs
-            for (auto& egg : eggs) {
-                if (egg.active && egg.isPoison) {
-                    egg.chaseStartTime = chaseDelay;
+            for (size_t i = 0; i < eggs.size(); i++) {
+                if (eggs.isPoison(i)) {
+                    eggs.chaseStartTime[i] = chaseDelay;
                 }
             }
         }
 
         // Display current chasing status
         int chasingCount = 0;
-        for (const auto& egg : eggs) {
-            if (egg.active && egg.isPoison && egg.isChasing) {
+        const unsigned char chasingMask = EGG_POISON | EGG_CHASING;
+        for (unsigned char flags : eggs.flags) {
+            if ((flags & chasingMask) == chasingMask) {
                 chasingCount++;
             }
         }
@@ -3731,7 +3354,12 @@ void showCameraSettingsWindow() {
     if (ImGui::CollapsingHeader("Effect System")) {
         ImGui::Text("Collection Effects: %zu", collectionEffects.size());
         ImGui::Text("Death Effects: %zu", deathEffects.size());
+        ImGui::Text("Effect Pool: %u/%u bursts", effectParticles.blocksInUse(), effectParticles.blockCount());
         ImGui::Text("Trail Particles: %zu", trailParticles.size());
+        ImGui::Text("Particle Kernels: %s", particleIsaName(activeParticleIsa()));
+        if (gpuParticles.available() && ImGui::Checkbox("GPU Particles", &useGpuParticles)) {
+            setGpuParticles(useGpuParticles);
+        }
 
         if (ImGui::Button("Test Collection Effect")) {
             createCollectionEffect(playerPos, glm::vec3(1.0f, 0.5f, 0.0f));
@@ -3791,6 +3419,59 @@ void showCameraSettingsWindow() {
         ImGui::SliderFloat("Shake Duration", &SCREEN_SHAKE_DURATION, 0.1f, 2.0f);
     }
 
+    if (ImGui::CollapsingHeader("Rendering")) {
+        ImGui::Text("Player LOD: %d", renderStats.playerLod);
+        ImGui::Text("Eggs per LOD: %d / %d / %d / %d", renderStats.eggsPerLod[0], renderStats.eggsPerLod[1],
+            renderStats.eggsPerLod[2], renderStats.eggsPerLod[3]);
+        ImGui::Text("Culled eggs: %d of %d", renderStats.eggs.culled, renderStats.eggs.total);
+        ImGui::Text("Culled trail particles: %d of %d", renderStats.trails.culled, renderStats.trails.total);
+        ImGui::Text("Culled miss crosses: %d of %d", renderStats.crosses.culled, renderStats.crosses.total);
+        ImGui::Text("Culled effect particles: %d of %d", renderStats.particles.culled, renderStats.particles.total);
+        ImGui::Text("3D draws: %d (program changes %d, VAO changes %d, texture changes %d)", renderStats.queue.draws,
+            renderStats.queue.programChanges, renderStats.queue.vertexArrayChanges, renderStats.queue.textureChanges);
+        ImGui::Text("Stream buffer: %d KB, %d waits", static_cast<int>(streamBuffer.capacity() / 1024), streamBuffer.waitCount());
+    }
+
+    if (ImGui::CollapsingHeader("Simulation")) {
+        ImGui::Checkbox("Fixed Timestep", &useFixedTimestep);
+        ImGui::SliderFloat("Tick Rate (Hz)", &simulationTickRate, 10.0f, 240.0f, "%.0f");
+        ImGui::SliderInt("Max Steps Per Frame", &maxSimulationStepsPerFrame, 1, 20);
+
+        ImGui::Separator();
+        ImGui::Text("Steps Last Frame: %d", simulationStepsLastFrame);
+        ImGui::Text("Accumulator: %.2f ms", simulationAccumulator * 1000.0f);
+        ImGui::Text("Render Alpha: %.2f", renderAlpha);
+        ImGui::Text("Simulation Time: %.1f seconds", simulationTime);
+
+        ImGui::Separator();
+        ImGui::Text("Match Seed: %llu", static_cast<unsigned long long>(randomMatchSeed()));
+        ImGui::Checkbox("Replay Seed On Reset", &replayMatchSeed);
+    }
+
+    if (ImGui::CollapsingHeader("Stress Test")) {
+        ImGui::InputFloat("Ground Size", &pendingStressConfig.groundSize, 10.0f, 1000.0f, "%.0f");
+        ImGui::InputInt("Max Eggs", &pendingStressConfig.maxEggs, 100, 10000);
+        ImGui::InputInt("Max Poison Eggs", &pendingStressConfig.maxPoisonEggs, 100, 10000);
+        ImGui::InputFloat("Egg Spawn Interval", &pendingStressConfig.eggSpawnInterval, 0.001f, 0.1f, "%.5f");
+        ImGui::InputInt("Collection Particles", &pendingStressConfig.collectionParticles, 8, 64);
+        ImGui::InputInt("Max Trail Particles", &pendingStressConfig.maxTrailParticles, 100, 10000);
+
+        if (ImGui::Button("Apply and Restart")) {
+            applyStressConfig(pendingStressConfig);
+            pendingStressConfig = currentStressConfig(); // Show the clamped values
+            groundMeshDirty = true;
+            resetGame();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Defaults")) {
+            pendingStressConfig = defaultStressConfig();
+        }
+
+        // Per-egg console output dominates frame time at stress populations
+        ImGui::Checkbox("Log Gameplay Events", &simulationLogging);
+        ImGui::Text("Eggs: %zu (grid %dx%d)", eggs.size(), eggGrid.cellsPerSide(), eggGrid.cellsPerSide());
+    }
+
     if (ImGui::CollapsingHeader("High Scores")) {
         ImGui::Text("Current High Score: %d", highScore);
         ImGui::Separator();
@@ -3967,7 +3648,20 @@ void showCameraSettingsWindow() {
     ImGui::End();
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // Stress limits from the command line
+    StressConfig stressConfig = defaultStressConfig();
+    for (int i = 1; i < argc; i++) {
+        if (!parseStressOption(argc, argv, i, stressConfig)) {
+            std::cout << "Unknown option: " << argv[i] << std::endl;
+            printStressOptions();
+            return -1;
+        }
+    }
+    applyStressConfig(stressConfig);
+    pendingStressConfig = currentStressConfig();
+    resetSimulation(); // Size the match containers for the configured limits
+
     std::cout << "Egg Collector - Fruit Ninja Style!" << std::endl;
     std::cout << "FRUIT NINJA RULES:" << std::endl;
     std::cout << "  - Collect ALL regular eggs (you can only miss " << MAX_MISSES << ")" << std::endl;
@@ -4025,8 +3719,21 @@ int main() {
     // Allocate mixing channels
     Mix_AllocateChannels(16);
 
-    // Seed random number generator
+    // Seed random number generator (debug tools) and the first match
     srand(static_cast<unsigned int>(time(nullptr)));
+    seedRandomStreams(newMatchSeed());
+
+    // Route simulation events to audio, postprocessing and the high score system
+    simulationCallbacks.onCollectionEffect = onCollectionEffect;
+    simulationCallbacks.onDeathEffect = onDeathEffect;
+    simulationCallbacks.onEggMissed = onEggMissed;
+    simulationCallbacks.onPlayerKilled = onPlayerKilled;
+    simulationCallbacks.onGameOver = onGameOver;
+
+    // Spread simulation updates over the spare cores
+    initJobSystem(-1);
+    frameArena.init(64 * 1024);
+    std::cout << "Job system: " << jobWorkerCount() << " worker threads" << std::endl;
 
     // Initialize high score system
     loadHighScores();
@@ -4071,9 +3778,9 @@ int main() {
         return -1;
     }
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setDepthTest(true);
+    glState.setBlend(true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Setup ImGui context
     IMGUI_CHECKVERSION();
@@ -4092,9 +3799,32 @@ int main() {
     checkJoystickConnection();
 
     // Create shader programs
-    unsigned int shaderProgram = createShaderProgram(vertexShaderSource, fragmentShaderSource);
-    unsigned int missShaderProgram = createShaderProgram(missVertexShaderSource, missFragmentShaderSource);
-    unsigned int effectShaderProgram = createShaderProgram(effectVertexShaderSource, effectFragmentShaderSource);
+    ShaderProgram shaderProgram, eggShaderProgram, missShaderProgram, effectShaderProgram, gpuEffectShaderProgram;
+    shaderProgram.create(vertexShaderSource, fragmentShaderSource);
+    eggShaderProgram.create(eggVertexShaderSource, eggFragmentShaderSource);
+    missShaderProgram.create(missVertexShaderSource, missFragmentShaderSource);
+    effectShaderProgram.create(effectVertexShaderSource, effectFragmentShaderSource);
+    gpuEffectShaderProgram.create(gpuEffectVertexShaderSource, effectFragmentShaderSource);
+    overlayShaderProgram.create(overlayVertexShaderSource, overlayFragmentShaderSource);
+    shaderProgram.bindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+    eggShaderProgram.bindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+    missShaderProgram.bindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+    effectShaderProgram.bindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+    gpuEffectShaderProgram.bindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+
+    // Effect particles move on the GPU unless the update program or its draw shader won't build
+    if (gpuEffectShaderProgram.id() != 0 && gpuParticles.init()) {
+        setGpuParticles(useGpuParticles);
+    }
+
+    // Camera uniform buffer, bound once to the binding point all 3D programs read from
+    glGenBuffers(1, &cameraUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraUniforms), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BINDING, cameraUBO);
+
+    // Ring buffer for per-frame vertex data; the text, icon and trail VAOs point into it
+    streamBuffer.create(STREAM_BUFFER_SIZE);
 
     // Initialize postprocessing
     initPostProcessing();
@@ -4113,110 +3843,64 @@ int main() {
 
     loadAudio();
 
-    // Generate sphere geometry for player
-    std::vector<float> sphereVertices;
-    std::vector<unsigned int> sphereIndices;
-
-    generateSphere(playerRadius, 36, 18, sphereVertices, sphereIndices);
-
-    // Generate sphere geometry for eggs (smaller spheres)
-    std::vector<float> eggVertices;
-    std::vector<unsigned int> eggIndices;
-    generateSphere(EGG_RADIUS, 24, 12, eggVertices, eggIndices);
-
-    // Generate sphere geometry for poison eggs (slightly larger)
-    std::vector<float> poisonEggVertices;
-    std::vector<unsigned int> poisonEggIndices;
-    generateSphere(POISON_EGG_RADIUS, 24, 12, poisonEggVertices, poisonEggIndices);
-
-    // Generate ground geometry
-    std::vector<float> groundVertices;
-    std::vector<unsigned int> groundIndices;
-    generateGround(groundVertices, groundIndices);
-
-    // Generate cross geometry for miss indicators
-    std::vector<float> crossVertices;
-    std::vector<unsigned int> crossIndices;
-    generateCross(crossVertices, crossIndices);
-
-    // Set up player sphere VAO, VBO, EBO
-    unsigned int sphereVAO, sphereVBO, sphereEBO;
-  
-    glGenVertexArrays(1, &sphereVAO);
-    glGenBuffers(1, &sphereVBO);
-    glGenBuffers(1, &sphereEBO);
-
-    glBindVertexArray(sphereVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, sphereVBO);
-    glBufferData(GL_ARRAY_BUFFER, sphereVertices.size() * sizeof(float), sphereVertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphereEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sphereIndices.size() * sizeof(unsigned int), sphereIndices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // All position + normal meshes share one vertex and index buffer
+    StaticGeometry staticGeometry;
+
+    // Sphere LOD chains for the player, eggs (smaller) and poison eggs (slightly larger)
+    SphereLodChain playerSphere, eggSphere, poisonEggSphere;
+    createSphereLodChain(playerSphere, staticGeometry, playerRadius, 36, 18);
+    createSphereLodChain(eggSphere, staticGeometry, EGG_RADIUS, 24, 12);
+    createSphereLodChain(poisonEggSphere, staticGeometry, POISON_EGG_RADIUS, 24, 12);
+
+    std::vector<float> meshVertices;
+    std::vector<unsigned int> meshIndices;
+
+    // Low-poly sphere for effect particles (80 triangles)
+    generateIcosphere(playerRadius, 1, meshVertices, meshIndices);
+    MeshRange particleMesh = staticGeometry.add(meshVertices, meshIndices);
 
-    // Set up egg sphere VAO, VBO, EBO
-    unsigned int eggVAO, eggVBO, eggEBO;
+    // Ground, with room for the finest grid so a GROUND_SIZE change can rebuild it in place
+    const size_t groundMaxVertices = (GROUND_MAX_DIVISIONS + 1) * (GROUND_MAX_DIVISIONS + 1);
+    const size_t groundMaxIndices = GROUND_MAX_DIVISIONS * GROUND_MAX_DIVISIONS * 6;
+    generateGround(meshVertices, meshIndices);
+    MeshRange groundMesh = staticGeometry.add(meshVertices, meshIndices, groundMaxVertices, groundMaxIndices);
+
+    // Cross for miss indicators
+    generateCross(meshVertices, meshIndices);
+    MeshRange crossMesh = staticGeometry.add(meshVertices, meshIndices);
+
+    staticGeometry.upload();
+
+    // One VAO per vertex format: plain meshes, eggs (egg instance data), effect particles
+    // (particle instance data) and GPU-moved effect particles (GPU particle buffers)
+    unsigned int meshVAO, eggVAO, particleVAO, gpuParticleVAO;
+    glGenVertexArrays(1, &meshVAO);
     glGenVertexArrays(1, &eggVAO);
-    glGenBuffers(1, &eggVBO);
-    glGenBuffers(1, &eggEBO);
-
-    glBindVertexArray(eggVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, eggVBO);
-    glBufferData(GL_ARRAY_BUFFER, eggVertices.size() * sizeof(float), eggVertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eggEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, eggIndices.size() * sizeof(unsigned int), eggIndices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    glGenVertexArrays(1, &particleVAO);
+    glGenVertexArrays(1, &gpuParticleVAO);
 
-    // Set up poison egg sphere VAO, VBO, EBO
-    unsigned int poisonEggVAO, poisonEggVBO, poisonEggEBO;
-    glGenVertexArrays(1, &poisonEggVAO);
-    glGenBuffers(1, &poisonEggVBO);
-    glGenBuffers(1, &poisonEggEBO);
-
-    glBindVertexArray(poisonEggVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, poisonEggVBO);
-    glBufferData(GL_ARRAY_BUFFER, poisonEggVertices.size() * sizeof(float), poisonEggVertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, poisonEggEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, poisonEggIndices.size() * sizeof(unsigned int), poisonEggIndices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    glState.bindVertexArray(meshVAO);
+    staticGeometry.attach();
+    glState.bindVertexArray(eggVAO);
+    staticGeometry.attach();
+    glState.bindVertexArray(particleVAO);
+    staticGeometry.attach();
+    glState.bindVertexArray(gpuParticleVAO);
+    staticGeometry.attach();
+    setupGpuParticleAttributes(gpuParticleVAO);
 
-    // Set up ground VAO, VBO, EBO
-    unsigned int groundVAO, groundVBO, groundEBO;
-    glGenVertexArrays(1, &groundVAO);
-    glGenBuffers(1, &groundVBO);
-    glGenBuffers(1, &groundEBO);
-
-    glBindVertexArray(groundVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, groundVBO);
-    glBufferData(GL_ARRAY_BUFFER, groundVertices.size() * sizeof(float), groundVertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, groundEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, groundIndices.size() * sizeof(unsigned int), groundIndices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // Per-instance egg data is written to the stream buffer every frame
+    setupEggInstanceAttributes(eggVAO);
 
-    // Set up cross VAO, VBO, EBO for miss indicators
-    unsigned int crossVAO, crossVBO, crossEBO;
-    glGenVertexArrays(1, &crossVAO);
-    glGenBuffers(1, &crossVBO);
-    glGenBuffers(1, &crossEBO);
-
-    glBindVertexArray(crossVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, crossVBO);
-    glBufferData(GL_ARRAY_BUFFER, crossVertices.size() * sizeof(float), crossVertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, crossEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, crossIndices.size() * sizeof(unsigned int), crossIndices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    // Draws of the 3D pass, sorted by state and depth each frame
+    RenderQueue renderQueue;
+
+    // Current LOD of the player and of each egg (by handle slot), for hysteresis
+    int playerLod = 0;
+    std::vector<unsigned char> eggLodBySlot;
+
+    // Per-instance effect particle data is too
+    setupParticleInstanceAttributes(particleVAO);
 
     // Light position
     glm::vec3 lightPos = glm::vec3(10.0f, 10.0f, 10.0f);
@@ -4225,23 +3909,18 @@ int main() {
     updateCamera();
     updateCameraVectors();
 
-    // Smooth damping velocity variables
-    glm::vec3 playerPosVelocity = glm::vec3(0.0f);
-    float playerRotationVelocity = 0.0f;
-    glm::vec3 cameraPosVelocity = glm::vec3(0.0f);
-    float cameraDistanceVelocity = 0.0f;
-    float cameraHeightVelocity = 0.0f;
-    float cameraAngleVelocity = 0.0f;
-
     // Enable line rendering for miss indicators
     glLineWidth(3.0f);
 
     // Main loop
     while (!glfwWindowShouldClose(window)) {
         float currentFrame = glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
+        float frameTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
+        // Input is sampled once per frame with the real frame time
+        deltaTime = frameTime;
+
         // Periodically check for joystick connection
         static float lastJoystickCheck = 0.0f;
         if (currentFrame - lastJoystickCheck > 2.0f) { // Check every 2 seconds
@@ -4254,45 +3933,26 @@ int main() {
 
         processInput(window);
 
+        if (groundMeshDirty) {
+            generateGround(meshVertices, meshIndices);
+            staticGeometry.replace(groundMesh, meshVertices, meshIndices);
+            groundMeshDirty = false;
+        }
+
         // Update game logic only when playing
         if (currentGameState == GAME_PLAYING) {
-            // Update egg system
-            updateEggs();
-
-            // Check for missed eggs (Fruit Ninja style) - MUST be called AFTER updateEggs
-            checkForMissedEggs();
-
-            // Update miss indicators
-            updateMissIndicators();
-
-            // Update effect systems
-            updateCollectionEffects();
-            updateDeathEffects();
-            updateTrailEffects(); // Update trail effects
-
-            // Update postprocessing effects
-            updatePostProcessing();
-
-            // Update player respawn
-            updatePlayer();
-
-            // Apply smooth damping to player position (only if alive)
-            if (playerAlive) {
-                playerPos = smoothDamp(playerPos, playerTargetPos, playerPosVelocity, positionSmoothTime, deltaTime);
-                playerRotation = smoothDamp(playerRotation, playerRotationTarget, playerRotationVelocity, rotationSmoothTime, deltaTime);
-            }
-
-            // Apply smooth damping to camera parameters
-            cameraDistance = smoothDamp(cameraDistance, cameraTargetDistance, cameraDistanceVelocity, cameraSmoothTime, deltaTime);
-            cameraHeight = smoothDamp(cameraHeight, cameraTargetHeight, cameraHeightVelocity, cameraSmoothTime, deltaTime);
-            cameraAngle = smoothDamp(cameraAngle, cameraTargetAngle, cameraAngleVelocity, cameraSmoothTime, deltaTime);
-
-            // Apply smooth damping to camera position
-            cameraPos = smoothDamp(cameraPos, cameraTargetPos, cameraPosVelocity, cameraSmoothTime, deltaTime);
-
-            // Update camera vectors after smooth damping
-            updateCameraVectors();
+            runSimulation(frameTime);
+        }
+        else {
+            simulationAccumulator = 0.0f;
+            renderAlpha = 1.0f;
         }
+        updateGpuParticles(frameTime);
+
+        // Interpolated positions for rendering
+        glm::vec3 renderPlayerPos = glm::mix(previousPlayerPos, playerPos, renderAlpha);
+        float renderPlayerRotation = glm::mix(previousPlayerRotation, playerRotation, renderAlpha);
+        glm::vec3 renderCameraPos = glm::mix(previousCameraPos, cameraPos, renderAlpha);
 
         // Start ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
@@ -4303,17 +3963,14 @@ int main() {
         showCameraSettingsWindow();
 
         // First render pass: render to framebuffer
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glState.bindFramebuffer(framebuffer);
         glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Render 3D scene for all states except start screen
         if (currentGameState != GAME_START) {
-            // Use main shader program for 3D objects
-            glUseProgram(shaderProgram);
-
             // View and projection matrices
-            glm::mat4 view = glm::lookAt(cameraPos, playerPos, cameraUp);
+            glm::mat4 view = glm::lookAt(renderCameraPos, renderPlayerPos, cameraUp);
 
             // Safe aspect ratio calculation
             float aspectRatio;
@@ -4334,80 +3991,163 @@ int main() {
             const float MAX_ASPECT_RATIO = 10.0f;
             aspectRatio = glm::clamp(aspectRatio, MIN_ASPECT_RATIO, MAX_ASPECT_RATIO);
 
-            glm::mat4 projection = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, 100.0f);
-
-            // Set shader uniforms
-            glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-            glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-            glUniform3fv(glGetUniformLocation(shaderProgram, "lightPos"), 1, glm::value_ptr(lightPos));
-            glUniform3fv(glGetUniformLocation(shaderProgram, "viewPos"), 1, glm::value_ptr(cameraPos));
-
-            // Render ground
-            glm::mat4 groundModel = glm::mat4(1.0f);
-            glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(groundModel));
-            glUniform3fv(glGetUniformLocation(shaderProgram, "objectColor"), 1, glm::value_ptr(glm::vec3(0.3f, 0.5f, 0.3f)));
-            glBindVertexArray(groundVAO);
-            glDrawElements(GL_TRIANGLES, groundIndices.size(), GL_UNSIGNED_INT, 0);
-
-            // Render player sphere (only if alive and in playing state)
+            glm::mat4 projection = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, CAMERA_FAR_PLANE);
+
+            // Screen pixels covered by one world unit at distance 1, for picking LODs
+            const float pixelsPerUnit = projection[1][1] * SCR_HEIGHT * 0.5f;
+
+            // Eggs, trails, miss crosses and effect particles are culled against this before drawing
+            const ViewFrustum frustum = makeViewFrustum(projection * view, renderCameraPos, CULL_MIN_PIXELS, pixelsPerUnit);
+            renderStats.eggs = renderStats.trails = renderStats.crosses = renderStats.particles = CullCounts();
+
+            // Upload the camera block once for every 3D program this frame
+            CameraUniforms camera;
+            camera.view = view;
+            camera.projection = projection;
+            camera.lightPos = lightPos;
+            camera.lightPosPadding = 0.0f;
+            camera.viewPos = renderCameraPos;
+            camera.viewPosPadding = 0.0f;
+            glBindBuffer(GL_UNIFORM_BUFFER, cameraUBO);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraUniforms), &camera);
+
+            // Queued draws keep stream buffer offsets until the queue executes, and growing the
+            // ring would invalidate them, so make room for the most instance data this pass can
+            // write (every egg, trail particle and CPU effect particle) before writing any
+            size_t effectParticleCount = 0;
+            if (!effectParticlesOnGpu) {
+                for (const auto& effect : collectionEffects) effectParticleCount += effect.particleCount;
+                for (const auto& effect : deathEffects) effectParticleCount += effect.particleCount;
+            }
+            streamBuffer.reserveFrame(eggs.size() * sizeof(EggInstance) + trailParticles.size() * sizeof(TrailInstance) +
+                effectParticleCount * sizeof(ParticleInstance), 4);
+
+            // Every 3D draw below is submitted to the render queue and drawn, sorted, at the end.
+            // Depths are distances from the camera as a fraction of the far plane.
+            auto queueDepth = [&](const glm::vec3& position) {
+                return glm::distance(position, renderCameraPos) / CAMERA_FAR_PLANE;
+            };
+
+            // Ground
+            DrawPacket groundPacket = meshPacket(shaderProgram, meshVAO, groundMesh);
+            groundPacket.setup = setupMeshDraw;
+            groundPacket.data = renderQueue.keep(MeshDraw{ glm::mat4(1.0f), glm::vec3(0.3f, 0.5f, 0.3f) });
+            renderQueue.submit(RENDER_PASS_OPAQUE, 0, 0.0f, groundPacket);
+
+            // Player sphere (only if alive and in playing state)
             if (playerAlive && currentGameState == GAME_PLAYING) {
                 glm::mat4 sphereModel = glm::mat4(1.0f);
-                sphereModel = glm::translate(sphereModel, playerPos);
-                sphereModel = glm::rotate(sphereModel, playerRotation, glm::vec3(0.0f, 1.0f, 0.0f));
+                sphereModel = glm::translate(sphereModel, renderPlayerPos);
+                sphereModel = glm::rotate(sphereModel, renderPlayerRotation, glm::vec3(0.0f, 1.0f, 0.0f));
                 glm::vec3 playerColor = glm::vec3(0.8f, 0.2f, 0.2f);
 
-                glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(sphereModel));
-                glUniform3fv(glGetUniformLocation(shaderProgram, "objectColor"), 1, glm::value_ptr(playerColor));
-                glBindVertexArray(sphereVAO);
-                glDrawElements(GL_TRIANGLES, sphereIndices.size(), GL_UNSIGNED_INT, 0);
+                playerLod = selectSphereLod(playerSphere, playerRadius * pixelsPerUnit / glm::distance(renderPlayerPos, renderCameraPos), playerLod);
+                DrawPacket playerPacket = meshPacket(shaderProgram, meshVAO, playerSphere.levels[playerLod]);
+                playerPacket.setup = setupMeshDraw;
+                playerPacket.data = renderQueue.keep(MeshDraw{ sphereModel, playerColor });
+                renderQueue.submit(RENDER_PASS_OPAQUE, 0, queueDepth(renderPlayerPos), playerPacket);
+                renderStats.playerLod = playerLod;
             }
 
-            // Render eggs with animations (only in playing state)
-            if (currentGameState == GAME_PLAYING) {
-                for (const auto& egg : eggs) {
-                    if (egg.active) {
-                        glm::mat4 eggModel = glm::mat4(1.0f);
-                        eggModel = glm::translate(eggModel, egg.position);
-
-                        // Apply scale animation
-                        float finalScale = egg.scale * egg.pulseFactor;
-                        eggModel = glm::scale(eggModel, glm::vec3(finalScale));
-
-                        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(eggModel));
-
-                        // Choose the appropriate VAO based on egg type
-                        if (egg.isPoison) {
-                            glBindVertexArray(poisonEggVAO);
-                            // Make poison eggs more vibrant, especially when chasing
-                            glm::vec3 finalColor = egg.isChasing ?
-                                glm::mix(egg.color, glm::vec3(1.0f, 0.0f, 0.0f), 0.3f) :
-                                egg.color * 1.2f;
-                            glUniform3fv(glGetUniformLocation(shaderProgram, "objectColor"), 1, glm::value_ptr(finalColor));
-                        }
-                        else {
-                            glBindVertexArray(eggVAO);
-                            glUniform3fv(glGetUniformLocation(shaderProgram, "objectColor"), 1, glm::value_ptr(egg.color));
-                        }
-
-                        glDrawElements(GL_TRIANGLES, eggIndices.size(), GL_UNSIGNED_INT, 0);
-                    }
+            // Eggs with animations (only in playing state). Instances are grouped by egg type and LOD,
+            // with one instanced draw per group.
+            for (int level = 0; level < SPHERE_LOD_COUNT; level++) renderStats.eggsPerLod[level] = 0;
+            if (currentGameState == GAME_PLAYING && !eggs.empty()) {
+                const size_t eggCount = eggs.size();
+
+                // Interpolated bounding spheres, culled as a batch
+                FrameVector<float> boundX(eggCount), boundY(eggCount), boundZ(eggCount), boundRadius(eggCount);
+                for (size_t i = 0; i < eggCount; i++) {
+                    boundX[i] = eggs.previousX[i] + (eggs.positionX[i] - eggs.previousX[i]) * renderAlpha;
+                    boundY[i] = eggs.previousY[i] + (eggs.positionY[i] - eggs.previousY[i]) * renderAlpha;
+                    boundZ[i] = eggs.previousZ[i] + (eggs.positionZ[i] - eggs.previousZ[i]) * renderAlpha;
+                    boundRadius[i] = eggs.radius[i] * eggs.scale[i] * eggs.pulseFactor[i];
+                }
+                FrameVector<uint32_t> visibleEggs(eggCount);
+                visibleEggs.resize(cullSpheres(frustum, boundX.data(), boundY.data(), boundZ.data(), boundRadius.data(),
+                    eggCount, visibleEggs.data()));
+                renderStats.eggs.total = static_cast<int>(eggCount);
+                renderStats.eggs.culled = static_cast<int>(eggCount - visibleEggs.size());
+
+                FrameVector<unsigned char> eggLods(eggCount);
+                size_t lodCounts[2][SPHERE_LOD_COUNT] = {};
+
+                for (uint32_t i : visibleEggs) {
+                    const int type = eggs.isPoison(i) ? 1 : 0;
+                    const SphereLodChain& chain = type ? poisonEggSphere : eggSphere;
+                    const uint32_t slot = eggs.handleAt(i).slot;
+                    if (slot >= eggLodBySlot.size()) eggLodBySlot.resize(slot + 1, 0);
+
+                    glm::vec3 position(boundX[i], boundY[i], boundZ[i]);
+                    float distance = glm::max(glm::distance(position, renderCameraPos), 0.001f);
+                    int lod = selectSphereLod(chain, boundRadius[i] * pixelsPerUnit / distance, eggLodBySlot[slot]);
+                    eggLodBySlot[slot] = static_cast<unsigned char>(lod);
+                    eggLods[i] = static_cast<unsigned char>(lod);
+                    lodCounts[type][lod]++;
                 }
-            }
 
-            // Render trail effects
-            renderTrailEffects(view, projection);
+                // Lay out each type's instances LOD by LOD
+                size_t lodStart[2][SPHERE_LOD_COUNT];
+                size_t typeCount[2];
+                for (int type = 0; type < 2; type++) {
+                    size_t offset = 0;
+                    for (int level = 0; level < SPHERE_LOD_COUNT; level++) {
+                        lodStart[type][level] = offset;
+                        offset += lodCounts[type][level];
+                        renderStats.eggsPerLod[level] += static_cast<int>(lodCounts[type][level]);
+                    }
+                    typeCount[type] = offset;
+                }
 
-            // Render miss indicators (Fruit Ninja style) - only in playing state
-            if (!missIndicators.empty() && currentGameState == GAME_PLAYING) {
-                glUseProgram(missShaderProgram);
+                FrameVector<EggInstance> instances[2] = { FrameVector<EggInstance>(typeCount[0]), FrameVector<EggInstance>(typeCount[1]) };
+                size_t next[2][SPHERE_LOD_COUNT];
+                std::copy(&lodStart[0][0], &lodStart[0][0] + 2 * SPHERE_LOD_COUNT, &next[0][0]);
+                for (uint32_t i : visibleEggs) {
+                    const int type = eggs.isPoison(i) ? 1 : 0;
+                    EggInstance& instance = instances[type][next[type][eggLods[i]]++];
+                    instance.position = glm::vec3(boundX[i], boundY[i], boundZ[i]);
+                    instance.scale = eggs.scale[i];
+                    instance.color = eggs.color[i];
+                    instance.pulse = eggs.pulseFactor[i];
+                    instance.chasing = eggs.hasFlag(i, EGG_CHASING) ? 1.0f : 0.0f;
+                }
 
-                // Set view and projection for miss shader
-                glUniformMatrix4fv(glGetUniformLocation(missShaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-                glUniformMatrix4fv(glGetUniformLocation(missShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+                const SphereLodChain* chains[2] = { &eggSphere, &poisonEggSphere };
+                for (int type = 0; type < 2; type++) {
+                    if (instances[type].empty()) continue;
+                    const size_t offset = streamBuffer.write(instances[type].data(), instances[type].size() * sizeof(EggInstance));
+
+                    for (int level = 0; level < SPHERE_LOD_COUNT; level++) {
+                        if (lodCounts[type][level] == 0) continue;
+                        DrawPacket packet = meshPacket(eggShaderProgram, eggVAO, chains[type]->levels[level], GL_TRIANGLES,
+                            static_cast<GLsizei>(lodCounts[type][level]));
+                        packet.setup = setupEggDraw;
+                        packet.data = renderQueue.keep(EggDraw{ offset, lodStart[type][level], type });
+                        renderQueue.submit(RENDER_PASS_OPAQUE, 0, 0.0f, packet);
+                    }
+                }
+            }
 
-                glBindVertexArray(crossVAO);
+            // Trail effects
+            submitTrailEffects(frustum, renderStats.trails, renderQueue);
 
-                for (const auto& indicator : missIndicators) {
+            // Miss indicators (Fruit Ninja style) - only in playing state
+            if (!missIndicators.empty() && currentGameState == GAME_PLAYING) {
+                // The scaled cross spans 1.5 units either side of its center
+                const size_t crossCount = missIndicators.size();
+                FrameVector<float> boundX(crossCount), boundY(crossCount, 0.2f), boundZ(crossCount), boundRadius(crossCount, 1.5f);
+                for (size_t i = 0; i < crossCount; i++) {
+                    boundX[i] = missIndicators[i].x;
+                    boundZ[i] = missIndicators[i].z;
+                }
+                FrameVector<uint32_t> visibleCrosses(crossCount);
+                visibleCrosses.resize(cullSpheres(frustum, boundX.data(), boundY.data(), boundZ.data(), boundRadius.data(),
+                    crossCount, visibleCrosses.data()));
+                renderStats.crosses.total = static_cast<int>(crossCount);
+                renderStats.crosses.culled = static_cast<int>(crossCount - visibleCrosses.size());
+
+                for (uint32_t visibleIndex : visibleCrosses) {
+                    const glm::vec3& indicator = missIndicators[visibleIndex];
                     glm::mat4 crossModel = glm::mat4(1.0f);
                     crossModel = glm::translate(crossModel, glm::vec3(indicator.x, 0.2f, indicator.z)); // Position above ground
                     crossModel = glm::scale(crossModel, glm::vec3(1.5f, 1.5f, 1.5f)); // Scale up the cross
@@ -4415,105 +4155,151 @@ int main() {
                     // Calculate alpha based on timer (fade out effect)
                     float alpha = indicator.y / missIndicatorDuration;
 
-                    glUniformMatrix4fv(glGetUniformLocation(missShaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(crossModel));
-                    glUniform1f(glGetUniformLocation(missShaderProgram, "alpha"), alpha);
-
                     // Draw as lines
-                    glDrawElements(GL_LINES, crossIndices.size(), GL_UNSIGNED_INT, 0);
+                    DrawPacket packet = meshPacket(missShaderProgram, meshVAO, crossMesh, GL_LINES);
+                    packet.setup = setupCrossDraw;
+                    packet.data = renderQueue.keep(CrossDraw{ crossModel, alpha });
+                    renderQueue.submit(RENDER_PASS_TRANSPARENT, LAYER_MISS_CROSSES,
+                        queueDepth(glm::vec3(indicator.x, 0.2f, indicator.z)), packet);
                 }
             }
 
-            // Render collection effects (Fruit Ninja style)
-            if (!collectionEffects.empty()) {
-                glUseProgram(effectShaderProgram);
-
-                // Set view and projection for effect shader
-                glUniformMatrix4fv(glGetUniformLocation(effectShaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-                glUniformMatrix4fv(glGetUniformLocation(effectShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-
-                glBindVertexArray(sphereVAO); // Use sphere geometry for particles
-
+            // Effect particles moved on the GPU: one instanced draw per burst, straight from the GPU
+            // buffers. Their positions never come back to the CPU, so they aren't culled, and the
+            // bursts keep their submission order (equal depths).
+            if ((!collectionEffects.empty() || !deathEffects.empty()) && effectParticlesOnGpu) {
+                auto drawBurst = [&](uint32_t firstParticle, uint32_t count, float shrink, float alpha) {
+                    DrawPacket packet = meshPacket(gpuEffectShaderProgram, gpuParticleVAO, particleMesh, GL_TRIANGLES,
+                        static_cast<GLsizei>(count));
+                    packet.setup = setupGpuBurstDraw;
+                    packet.data = renderQueue.keep(GpuBurstDraw{ firstParticle, shrink, alpha });
+                    renderQueue.submit(RENDER_PASS_TRANSPARENT, LAYER_EFFECT_PARTICLES, 0.0f, packet);
+                    renderStats.particles.total += static_cast<int>(count);
+                };
+
+                // Same fades as the CPU path below, collections first
                 for (const auto& effect : collectionEffects) {
-                    if (effect.active) {
-                        float progress = 1.0f - (effect.timer / effect.duration);
-                        float alpha = (1.0f - progress) * 0.8f; // Fade out
-
-                        glUniform3fv(glGetUniformLocation(effectShaderProgram, "effectColor"), 1, glm::value_ptr(effect.color));
-                        glUniform1f(glGetUniformLocation(effectShaderProgram, "alpha"), alpha);
-
-                        // Render each particle
-                        for (size_t i = 0; i < effect.particlePositions.size(); i++) {
-                            glm::mat4 particleModel = glm::mat4(1.0f);
-                            particleModel = glm::translate(particleModel, effect.particlePositions[i]);
-                            particleModel = glm::rotate(particleModel, effect.particleRotations[i], glm::vec3(0.0f, 1.0f, 0.0f));
-                            particleModel = glm::scale(particleModel, effect.particleSizes[i] * (1.0f - progress * 0.5f)); // Shrink over time
-
-                            glUniformMatrix4fv(glGetUniformLocation(effectShaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(particleModel));
-                            glDrawElements(GL_TRIANGLES, sphereIndices.size(), GL_UNSIGNED_INT, 0);
-                        }
-                    }
+                    if (!effect.active) continue;
+                    float progress = 1.0f - (effect.timer / effect.duration);
+                    drawBurst(effect.firstParticle, effect.particleCount, 1.0f - progress * 0.5f, (1.0f - progress) * 0.8f);
+                }
+                for (const auto& effect : deathEffects) {
+                    if (!effect.active) continue;
+                    float progress = 1.0f - (effect.timer / effect.duration);
+                    drawBurst(effect.firstParticle, effect.particleCount, 1.0f - progress * 0.7f, (1.0f - progress) * 0.6f);
                 }
             }
 
-            // Render death effects
-            if (!deathEffects.empty()) {
-                glUseProgram(effectShaderProgram);
-
-                // Set view and projection for effect shader
-                glUniformMatrix4fv(glGetUniformLocation(effectShaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-                glUniformMatrix4fv(glGetUniformLocation(effectShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+            // Otherwise render collection and death effect particles as one instanced batch
+            // (collections first, matching the old draw order for blending)
+            if ((!collectionEffects.empty() || !deathEffects.empty()) && !effectParticlesOnGpu) {
+                size_t particleCount = 0;
+                for (const auto& effect : collectionEffects) particleCount += effect.particleCount;
+                for (const auto& effect : deathEffects) particleCount += effect.particleCount;
+
+                FrameVector<ParticleInstance> particleInstances;
+                particleInstances.reserve(particleCount);
+
+                // Cull one burst's particles, which sit contiguously in the pool, and return the survivors
+                // (relative to the burst's first particle)
+                FrameVector<float> boundRadius;
+                FrameVector<uint32_t> visibleParticles;
+                auto cullBurst = [&](uint32_t firstParticle, uint32_t count, float shrink) {
+                    boundRadius.resize(count);
+                    visibleParticles.resize(count);
+                    for (uint32_t i = 0; i < count; i++) {
+                        const glm::vec3& size = effectParticles.size[firstParticle + i];
+                        boundRadius[i] = playerRadius * glm::max(size.x, glm::max(size.y, size.z)) * shrink;
+                    }
+                    const ParticleArrays& particles = effectParticles.particles;
+                    visibleParticles.resize(cullSpheres(frustum, particles.positionX.data() + firstParticle,
+                        particles.positionY.data() + firstParticle, particles.positionZ.data() + firstParticle,
+                        boundRadius.data(), count, visibleParticles.data()));
+                    renderStats.particles.total += static_cast<int>(count);
+                    renderStats.particles.culled += static_cast<int>(count - visibleParticles.size());
+                };
 
-                glBindVertexArray(sphereVAO);
+                for (const auto& effect : collectionEffects) {
+                    if (!effect.active) continue;
+                    float progress = 1.0f - (effect.timer / effect.duration);
+                    float alpha = (1.0f - progress) * 0.8f; // Fade out
+                    float shrink = 1.0f - progress * 0.5f;  // Shrink over time
+
+                    cullBurst(effect.firstParticle, effect.particleCount, shrink);
+                    for (uint32_t visibleIndex : visibleParticles) {
+                        const uint32_t i = effect.firstParticle + visibleIndex;
+                        ParticleInstance instance;
+                        instance.position = effectParticles.position(i);
+                        instance.rotation = effectParticles.rotation[i];
+                        instance.size = effectParticles.size[i] * shrink;
+                        instance.alpha = alpha;
+                        instance.color = effect.color;
+                        particleInstances.push_back(instance);
+                    }
+                }
 
                 for (const auto& effect : deathEffects) {
-                    if (effect.active) {
-                        float progress = 1.0f - (effect.timer / effect.duration);
-                        float alpha = (1.0f - progress) * 0.6f; // Fade out
-
-                        // Render each particle with its own color
-                        for (size_t i = 0; i < effect.particlePositions.size(); i++) {
-                            glm::mat4 particleModel = glm::mat4(1.0f);
-                            particleModel = glm::translate(particleModel, effect.particlePositions[i]);
-                            particleModel = glm::scale(particleModel, effect.particleSizes[i] * (1.0f - progress * 0.7f)); // Shrink over time
-
-                            glUniform3fv(glGetUniformLocation(effectShaderProgram, "effectColor"), 1, glm::value_ptr(effect.particleColors[i]));
-                            glUniform1f(glGetUniformLocation(effectShaderProgram, "alpha"), alpha);
-                            glUniformMatrix4fv(glGetUniformLocation(effectShaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(particleModel));
-                            glDrawElements(GL_TRIANGLES, sphereIndices.size(), GL_UNSIGNED_INT, 0);
-                        }
+                    if (!effect.active) continue;
+                    float progress = 1.0f - (effect.timer / effect.duration);
+                    float alpha = (1.0f - progress) * 0.6f; // Fade out
+                    float shrink = 1.0f - progress * 0.7f;  // Shrink over time
+
+                    // Each particle has its own color
+                    cullBurst(effect.firstParticle, effect.particleCount, shrink);
+                    for (uint32_t visibleIndex : visibleParticles) {
+                        const uint32_t i = effect.firstParticle + visibleIndex;
+                        ParticleInstance instance;
+                        instance.position = effectParticles.position(i);
+                        instance.rotation = 0.0f;
+                        instance.size = effectParticles.size[i] * shrink;
+                        instance.alpha = alpha;
+                        instance.color = effectParticles.color[i];
+                        particleInstances.push_back(instance);
                     }
                 }
+
+                if (!particleInstances.empty()) {
+                    const size_t offset = streamBuffer.write(particleInstances.data(),
+                        particleInstances.size() * sizeof(ParticleInstance));
+                    DrawPacket packet = meshPacket(effectShaderProgram, particleVAO, particleMesh, GL_TRIANGLES,
+                        static_cast<GLsizei>(particleInstances.size()));
+                    packet.setup = setupParticleDraw;
+                    packet.data = renderQueue.keep(offset);
+                    renderQueue.submit(RENDER_PASS_TRANSPARENT, LAYER_EFFECT_PARTICLES, 0.0f, packet);
+                }
             }
+
+            renderQueue.execute(renderStats.queue);
         }
 
         // Second render pass: render framebuffer texture to screen with postprocessing
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glState.bindFramebuffer(0);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Use postprocessing shader
-        glUseProgram(postprocessShaderProgram);
-        glBindVertexArray(postprocessVAO);
-        glDisable(GL_DEPTH_TEST);
+        postprocessShaderProgram.use();
+        glState.bindVertexArray(postprocessVAO);
+        glState.setDepthTest(false);
 
         // Bind the framebuffer texture
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureColorbuffer);
+        glState.activeTexture(GL_TEXTURE0);
+        glState.bindTexture2D(textureColorbuffer);
 
         // Set postprocessing uniforms
-        glUniform1f(glGetUniformLocation(postprocessShaderProgram, "time"), currentFrame);
-        glUniform2f(glGetUniformLocation(postprocessShaderProgram, "screenSize"), (float)SCR_WIDTH, (float)SCR_HEIGHT);
+        postprocessShaderProgram.setFloat("time", currentFrame);
+        postprocessShaderProgram.setVec2("screenSize", glm::vec2((float)SCR_WIDTH, (float)SCR_HEIGHT));
 
         // Calculate shake intensity (fade out over time)
         float shakeIntensity = 0.0f;
         if (screenShakeEffect.active) {
             shakeIntensity = screenShakeEffect.intensity * (screenShakeEffect.timer / screenShakeEffect.duration);
         }
-        glUniform1f(glGetUniformLocation(postprocessShaderProgram, "shakeIntensity"), shakeIntensity);
+        postprocessShaderProgram.setFloat("shakeIntensity", shakeIntensity);
 
         // Render the quad with postprocessing effects
         glDrawArrays(GL_TRIANGLES, 0, 6);
-        glEnable(GL_DEPTH_TEST);
+        glState.setDepthTest(true);
 
         // Render appropriate UI based on game state
         switch (currentGameState) {
@@ -4546,7 +4332,9 @@ int main() {
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
+        streamBuffer.endFrame();
         glfwSwapBuffers(window);
+        frameArena.reset(); // Text formatted this frame has been drawn
         glfwPollEvents();
     }
 
@@ -4565,12 +4353,12 @@ int main() {
     glDeleteRenderbuffers(1, &rbo);
     glDeleteVertexArrays(1, &postprocessVAO);
     glDeleteBuffers(1, &postprocessVBO);
-    glDeleteProgram(postprocessShaderProgram);
+    postprocessShaderProgram.destroy();
 
     // Clean up text rendering resources
-    glDeleteProgram(textShaderProgram);
+    textShaderProgram.destroy();
+    overlayShaderProgram.destroy();
     glDeleteVertexArrays(1, &textVAO);
-    glDeleteBuffers(1, &textVBO);
     for (auto& character : Characters) {
         glDeleteTextures(1, &character.second.TextureID);
     }
@@ -4578,34 +4366,30 @@ int main() {
     // Clean up icon rendering resources
     glDeleteTextures(1, &eggIconTexture);
     glDeleteVertexArrays(1, &iconVAO);
-    glDeleteBuffers(1, &iconVBO);
-    glDeleteProgram(iconShaderProgram);
+    iconShaderProgram.destroy();
 
     // Clean up trail texture
     glDeleteTextures(1, &trailTexture);  
+    trailShaderProgram.destroy();
 
     // Call cleanupAudio 
     cleanupAudio();
 
-    glDeleteVertexArrays(1, &sphereVAO);
+    glDeleteVertexArrays(1, &meshVAO);
     glDeleteVertexArrays(1, &eggVAO);
-    glDeleteVertexArrays(1, &poisonEggVAO);
-    glDeleteVertexArrays(1, &groundVAO);
-    glDeleteVertexArrays(1, &crossVAO);
-    glDeleteBuffers(1, &sphereVBO);
-    glDeleteBuffers(1, &eggVBO);
-    glDeleteBuffers(1, &poisonEggVBO);
-    glDeleteBuffers(1, &groundVBO);
-    glDeleteBuffers(1, &crossVBO);
-    glDeleteBuffers(1, &sphereEBO);
-    glDeleteBuffers(1, &eggEBO);
-    glDeleteBuffers(1, &poisonEggEBO);
-    glDeleteBuffers(1, &groundEBO);
-    glDeleteBuffers(1, &crossEBO);
-    glDeleteProgram(shaderProgram);
-    glDeleteProgram(missShaderProgram);
-    glDeleteProgram(effectShaderProgram);
-
+    glDeleteVertexArrays(1, &particleVAO);
+    glDeleteVertexArrays(1, &gpuParticleVAO);
+    staticGeometry.destroy();
+    streamBuffer.destroy();
+    glDeleteBuffers(1, &cameraUBO);
+    shaderProgram.destroy();
+    eggShaderProgram.destroy();
+    missShaderProgram.destroy();
+    effectShaderProgram.destroy();
+    gpuEffectShaderProgram.destroy();
+    gpuParticles.destroy();
+
+    shutdownJobSystem();
     glfwTerminate();
 
     std::cout << "Application terminated successfully! Final Score: " << score << std::endl;
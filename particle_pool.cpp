@@ -0,0 +1,59 @@
+#include "particle_pool.h"
+
+void ParticlePool::init(uint32_t blockCount, uint32_t blockParticles) {
+    particlesPerBlock = blockParticles;
+    totalBlocks = blockCount;
+
+    const size_t capacity = static_cast<size_t>(blockCount) * blockParticles;
+    particles.positionX.assign(capacity, 0.0f);
+    particles.positionY.assign(capacity, 0.0f);
+    particles.positionZ.assign(capacity, 0.0f);
+    particles.velocityX.assign(capacity, 0.0f);
+    particles.velocityY.assign(capacity, 0.0f);
+    particles.velocityZ.assign(capacity, 0.0f);
+    size.assign(capacity, glm::vec3(0.0f));
+    color.assign(capacity, glm::vec3(0.0f));
+    rotation.assign(capacity, 0.0f);
+    rotationSpeed.assign(capacity, 0.0f);
+
+    freeBlocks.reserve(blockCount);
+    releaseAll();
+}
+
+bool ParticlePool::allocate(uint32_t& firstParticle) {
+    if (freeBlocks.empty()) return false;
+    firstParticle = freeBlocks.back() * particlesPerBlock;
+    freeBlocks.pop_back();
+    return true;
+}
+
+void ParticlePool::release(uint32_t firstParticle) {
+    freeBlocks.push_back(firstParticle / particlesPerBlock);
+}
+
+void ParticlePool::releaseAll() {
+    // Hand blocks out from the front of the pool first
+    freeBlocks.clear();
+    for (uint32_t block = totalBlocks; block > 0; block--) {
+        freeBlocks.push_back(block - 1);
+    }
+}
+
+void ParticlePool::set(uint32_t i, const glm::vec3& position, const glm::vec3& velocity) {
+    particles.positionX[i] = position.x;
+    particles.positionY[i] = position.y;
+    particles.positionZ[i] = position.z;
+    particles.velocityX[i] = velocity.x;
+    particles.velocityY[i] = velocity.y;
+    particles.velocityZ[i] = velocity.z;
+}
+
+void ParticlePool::integrate(uint32_t firstParticle, uint32_t count, float gravity, float dt) {
+    integrateParticles(particles.positionX.data() + firstParticle, particles.positionY.data() + firstParticle,
+        particles.positionZ.data() + firstParticle, particles.velocityX.data() + firstParticle,
+        particles.velocityY.data() + firstParticle, particles.velocityZ.data() + firstParticle, count, gravity, dt);
+}
+
+void ParticlePool::advanceRotation(uint32_t firstParticle, uint32_t count, float dt) {
+    advanceValues(rotation.data() + firstParticle, rotationSpeed.data() + firstParticle, count, dt);
+}
@@ -0,0 +1,43 @@
+#pragma once
+// Preallocated particle storage shared by effect bursts.
+// The pool is split into equal blocks. Each burst (emitter) takes one block and keeps only its
+// offset, so spawning and retiring bursts never touches the heap. Particle data is stored as
+// arrays per component so the SIMD kernels can run over a block directly.
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "particle_simd.h"
+
+struct ParticlePool {
+    ParticleArrays particles;
+    std::vector<glm::vec3> size;
+    std::vector<glm::vec3> color;
+    std::vector<float> rotation;
+    std::vector<float> rotationSpeed;
+
+    // Allocate storage for blockCount bursts of up to particlesPerBlock particles each.
+    // Any blocks in use are released.
+    void init(uint32_t blockCount, uint32_t particlesPerBlock);
+
+    // Take a free block and return the index of its first particle; false when the pool is full
+    bool allocate(uint32_t& firstParticle);
+    void release(uint32_t firstParticle);
+    void releaseAll();
+
+    uint32_t blockSize() const { return particlesPerBlock; }
+    uint32_t blockCount() const { return totalBlocks; }
+    uint32_t blocksInUse() const { return totalBlocks - static_cast<uint32_t>(freeBlocks.size()); }
+
+    glm::vec3 position(uint32_t i) const { return particles.position(i); }
+    void set(uint32_t i, const glm::vec3& position, const glm::vec3& velocity);
+
+    // Run the particle kernels over one burst
+    void integrate(uint32_t firstParticle, uint32_t count, float gravity, float dt);
+    void advanceRotation(uint32_t firstParticle, uint32_t count, float dt);
+
+private:
+    std::vector<uint32_t> freeBlocks;
+    uint32_t particlesPerBlock = 0;
+    uint32_t totalBlocks = 0;
+};
@@ -0,0 +1,225 @@
+#include "particle_simd.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define PARTICLE_SIMD_X86 0
+#endif
+
+// GCC and Clang need AVX2 code marked per function; MSVC accepts the intrinsics anywhere
+#if PARTICLE_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define PARTICLE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PARTICLE_TARGET_AVX2
+#endif
+
+void ParticleArrays::push(const glm::vec3& position, const glm::vec3& velocity) {
+    positionX.push_back(position.x);
+    positionY.push_back(position.y);
+    positionZ.push_back(position.z);
+    velocityX.push_back(velocity.x);
+    velocityY.push_back(velocity.y);
+    velocityZ.push_back(velocity.z);
+}
+
+void ParticleArrays::clear() {
+    positionX.clear();
+    positionY.clear();
+    positionZ.clear();
+    velocityX.clear();
+    velocityY.clear();
+    velocityZ.clear();
+}
+
+void ParticleArrays::reserve(size_t count) {
+    positionX.reserve(count);
+    positionY.reserve(count);
+    positionZ.reserve(count);
+    velocityX.reserve(count);
+    velocityY.reserve(count);
+    velocityZ.reserve(count);
+}
+
+// Scalar kernels, also used for the tails the vector kernels leave over
+
+static void integrateScalar(float* px, float* py, float* pz, const float* vx, float* vy, const float* vz,
+    size_t begin, size_t count, float gravityStep, float dt) {
+    for (size_t i = begin; i < count; i++) {
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        pz[i] += vz[i] * dt;
+        vy[i] -= gravityStep;
+    }
+}
+
+static void advanceScalar(float* values, const float* rates, size_t begin, size_t count, float dt) {
+    for (size_t i = begin; i < count; i++) {
+        values[i] += rates[i] * dt;
+    }
+}
+
+static void integrateParticlesScalar(float* px, float* py, float* pz, const float* vx, float* vy, const float* vz,
+    size_t count, float gravityStep, float dt) {
+    integrateScalar(px, py, pz, vx, vy, vz, 0, count, gravityStep, dt);
+}
+
+static void advanceValuesScalar(float* values, const float* rates, size_t count, float dt) {
+    advanceScalar(values, rates, 0, count, dt);
+}
+
+#if PARTICLE_SIMD_X86
+
+static void integrateParticlesSse2(float* px, float* py, float* pz, const float* vx, float* vy, const float* vz,
+    size_t count, float gravityStep, float dt) {
+    const __m128 dtVector = _mm_set1_ps(dt);
+    const __m128 gravityVector = _mm_set1_ps(gravityStep);
+    const size_t vectorCount = count & ~static_cast<size_t>(3);
+
+    for (size_t i = 0; i < vectorCount; i += 4) {
+        __m128 velocityY = _mm_loadu_ps(vy + i);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(_mm_loadu_ps(vx + i), dtVector)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(velocityY, dtVector)));
+        _mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(_mm_loadu_ps(vz + i), dtVector)));
+        _mm_storeu_ps(vy + i, _mm_sub_ps(velocityY, gravityVector));
+    }
+    integrateScalar(px, py, pz, vx, vy, vz, vectorCount, count, gravityStep, dt);
+}
+
+static void advanceValuesSse2(float* values, const float* rates, size_t count, float dt) {
+    const __m128 dtVector = _mm_set1_ps(dt);
+    const size_t vectorCount = count & ~static_cast<size_t>(3);
+
+    for (size_t i = 0; i < vectorCount; i += 4) {
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(_mm_loadu_ps(rates + i), dtVector)));
+    }
+    advanceScalar(values, rates, vectorCount, count, dt);
+}
+
+PARTICLE_TARGET_AVX2
+static void integrateParticlesAvx2(float* px, float* py, float* pz, const float* vx, float* vy, const float* vz,
+    size_t count, float gravityStep, float dt) {
+    const __m256 dtVector = _mm256_set1_ps(dt);
+    const __m256 gravityVector = _mm256_set1_ps(gravityStep);
+    const size_t vectorCount = count & ~static_cast<size_t>(7);
+
+    // Separate multiply and add (no FMA) so rounding matches the other paths
+    for (size_t i = 0; i < vectorCount; i += 8) {
+        __m256 velocityY = _mm256_loadu_ps(vy + i);
+        _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), dtVector)));
+        _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(velocityY, dtVector)));
+        _mm256_storeu_ps(pz + i, _mm256_add_ps(_mm256_loadu_ps(pz + i), _mm256_mul_ps(_mm256_loadu_ps(vz + i), dtVector)));
+        _mm256_storeu_ps(vy + i, _mm256_sub_ps(velocityY, gravityVector));
+    }
+    integrateScalar(px, py, pz, vx, vy, vz, vectorCount, count, gravityStep, dt);
+}
+
+PARTICLE_TARGET_AVX2
+static void advanceValuesAvx2(float* values, const float* rates, size_t count, float dt) {
+    const __m256 dtVector = _mm256_set1_ps(dt);
+    const size_t vectorCount = count & ~static_cast<size_t>(7);
+
+    for (size_t i = 0; i < vectorCount; i += 8) {
+        _mm256_storeu_ps(values + i, _mm256_add_ps(_mm256_loadu_ps(values + i), _mm256_mul_ps(_mm256_loadu_ps(rates + i), dtVector)));
+    }
+    advanceScalar(values, rates, vectorCount, count, dt);
+}
+
+static bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // AVX needs both CPU support and the OS saving YMM registers
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // PARTICLE_SIMD_X86
+
+struct ParticleKernels {
+    void (*integrate)(float*, float*, float*, const float*, float*, const float*, size_t, float, float);
+    void (*advance)(float*, const float*, size_t, float);
+};
+
+static const ParticleKernels particleKernels[PARTICLE_ISA_COUNT] = {
+    { integrateParticlesScalar, advanceValuesScalar },
+#if PARTICLE_SIMD_X86
+    { integrateParticlesSse2, advanceValuesSse2 },
+    { integrateParticlesAvx2, advanceValuesAvx2 },
+#else
+    { integrateParticlesScalar, advanceValuesScalar },
+    { integrateParticlesScalar, advanceValuesScalar },
+#endif
+};
+
+bool particleIsaSupported(ParticleIsa isa) {
+    switch (isa) {
+    case PARTICLE_ISA_SCALAR:
+        return true;
+#if PARTICLE_SIMD_X86
+    case PARTICLE_ISA_SSE2:
+        return true;
+    case PARTICLE_ISA_AVX2: {
+        static const bool hasAvx2 = cpuHasAvx2();
+        return hasAvx2;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+ParticleIsa bestParticleIsa() {
+    if (particleIsaSupported(PARTICLE_ISA_AVX2)) return PARTICLE_ISA_AVX2;
+    if (particleIsaSupported(PARTICLE_ISA_SSE2)) return PARTICLE_ISA_SSE2;
+    return PARTICLE_ISA_SCALAR;
+}
+
+static ParticleIsa currentParticleIsa = bestParticleIsa();
+
+ParticleIsa activeParticleIsa() {
+    return currentParticleIsa;
+}
+
+void setParticleIsa(ParticleIsa isa) {
+    currentParticleIsa = (isa < PARTICLE_ISA_COUNT && particleIsaSupported(isa)) ? isa : bestParticleIsa();
+}
+
+const char* particleIsaName(ParticleIsa isa) {
+    switch (isa) {
+    case PARTICLE_ISA_SCALAR: return "scalar";
+    case PARTICLE_ISA_SSE2: return "SSE2";
+    case PARTICLE_ISA_AVX2: return "AVX2";
+    default: return "unknown";
+    }
+}
+
+void integrateParticles(float* positionX, float* positionY, float* positionZ,
+    const float* velocityX, float* velocityY, const float* velocityZ, size_t count, float gravity, float dt) {
+    particleKernels[currentParticleIsa].integrate(positionX, positionY, positionZ, velocityX, velocityY, velocityZ,
+        count, gravity * dt, dt);
+}
+
+void integrateParticles(ParticleArrays& particles, float gravity, float dt) {
+    if (particles.size() == 0) return;
+    integrateParticles(particles.positionX.data(), particles.positionY.data(), particles.positionZ.data(),
+        particles.velocityX.data(), particles.velocityY.data(), particles.velocityZ.data(), particles.size(), gravity, dt);
+}
+
+void advanceValues(float* values, const float* rates, size_t count, float dt) {
+    particleKernels[currentParticleIsa].advance(values, rates, count, dt);
+}
@@ -0,0 +1,47 @@
+#pragma once
+// SIMD particle kernels over struct-of-arrays particle data.
+// Every kernel has scalar, SSE2 and AVX2 versions. The best one the CPU supports is picked at
+// startup and can be overridden to benchmark or compare paths. All versions do the same
+// multiply-then-add per element, so their results agree to within float rounding.
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+enum ParticleIsa {
+    PARTICLE_ISA_SCALAR,
+    PARTICLE_ISA_SSE2,
+    PARTICLE_ISA_AVX2,
+    PARTICLE_ISA_COUNT
+};
+
+// Particle positions and velocities, one array per component
+struct ParticleArrays {
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> positionZ;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> velocityZ;
+
+    size_t size() const { return positionX.size(); }
+    glm::vec3 position(size_t i) const { return glm::vec3(positionX[i], positionY[i], positionZ[i]); }
+    glm::vec3 velocity(size_t i) const { return glm::vec3(velocityX[i], velocityY[i], velocityZ[i]); }
+
+    void push(const glm::vec3& position, const glm::vec3& velocity);
+    void clear();
+    void reserve(size_t count);
+};
+
+// position += velocity * dt, then velocity.y -= gravity * dt
+void integrateParticles(float* positionX, float* positionY, float* positionZ,
+    const float* velocityX, float* velocityY, const float* velocityZ, size_t count, float gravity, float dt);
+void integrateParticles(ParticleArrays& particles, float gravity, float dt);
+
+// values[i] += rates[i] * dt
+void advanceValues(float* values, const float* rates, size_t count, float dt);
+
+bool particleIsaSupported(ParticleIsa isa);
+ParticleIsa bestParticleIsa();
+ParticleIsa activeParticleIsa();
+void setParticleIsa(ParticleIsa isa); // Unsupported choices fall back to the best supported one
+const char* particleIsaName(ParticleIsa isa);
@@ -0,0 +1,128 @@
+#include "render_queue.h"
+#include "gl_state.h"
+#include <algorithm>
+
+static const int DEPTH_BITS = 24;
+static const uint32_t DEPTH_MAX = (1u << DEPTH_BITS) - 1;
+
+DrawPacket meshPacket(ShaderProgram& program, GLuint vertexArray, const MeshRange& mesh, GLenum mode, GLsizei instanceCount) {
+    DrawPacket packet;
+    packet.program = &program;
+    packet.vertexArray = vertexArray;
+    packet.mode = mode;
+    packet.indexType = GL_UNSIGNED_SHORT; // StaticGeometry's index format
+    packet.indexCount = mesh.indexCount;
+    packet.indexOffset = mesh.indexOffset;
+    packet.baseVertex = mesh.baseVertex;
+    packet.instanceCount = instanceCount;
+    return packet;
+}
+
+uint64_t RenderQueue::sortKey(RenderPass pass, int layer, float depth, const DrawPacket& packet) {
+    const uint64_t program = packet.program->id() & 0xFF;
+    const uint64_t vertexArray = packet.vertexArray & 0xFF;
+    const uint64_t texture = packet.texture & 0xFF;
+    const uint64_t state = program << 16 | vertexArray << 8 | texture;
+    uint64_t quantizedDepth = static_cast<uint64_t>(std::min(std::max(depth, 0.0f), 1.0f) * DEPTH_MAX);
+
+    uint64_t key = static_cast<uint64_t>(pass) << 62 | static_cast<uint64_t>(layer & (MAX_LAYERS - 1)) << 58;
+    if (pass == RENDER_PASS_OPAQUE) {
+        key |= state << 34 | quantizedDepth << 10;
+    }
+    else {
+        key |= (DEPTH_MAX - quantizedDepth) << 34 | state << 10;
+    }
+    return key;
+}
+
+void RenderQueue::submit(RenderPass pass, int layer, float depth, const DrawPacket& packet) {
+    entries.push_back({ sortKey(pass, layer, depth, packet), static_cast<uint32_t>(packets.size()) });
+    packets.push_back(packet);
+}
+
+// Least significant byte first, one counting pass per byte. Each pass is stable, so the whole
+// sort is; bytes that are the same in every key are skipped.
+void RenderQueue::sortEntries() {
+    const size_t count = entries.size();
+    uint32_t histograms[8][256] = {};
+    for (const Entry& entry : entries) {
+        for (int byte = 0; byte < 8; byte++) {
+            histograms[byte][(entry.key >> (byte * 8)) & 0xFF]++;
+        }
+    }
+
+    scratch.resize(count);
+    for (int byte = 0; byte < 8; byte++) {
+        uint32_t* histogram = histograms[byte];
+        if (histogram[(entries[0].key >> (byte * 8)) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (int value = 0; value < 256; value++) {
+            const uint32_t bucket = histogram[value];
+            histogram[value] = offset;
+            offset += bucket;
+        }
+        for (const Entry& entry : entries) {
+            scratch[histogram[(entry.key >> (byte * 8)) & 0xFF]++] = entry;
+        }
+        entries.swap(scratch);
+    }
+}
+
+void RenderQueue::execute(RenderQueueStats& stats) {
+    stats = RenderQueueStats();
+    if (entries.empty()) return;
+    sortEntries();
+
+    int pass = -1;
+    ShaderProgram* program = nullptr;
+    GLuint vertexArray = 0;
+    GLuint texture = 0;
+    bool vertexArrayBound = false;
+
+    for (const Entry& entry : entries) {
+        const DrawPacket& packet = packets[entry.packet];
+
+        const int entryPass = static_cast<int>(entry.key >> 62);
+        if (entryPass != pass) {
+            const bool transparent = entryPass == RENDER_PASS_TRANSPARENT;
+            glState.setBlend(transparent);
+            if (transparent) glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glState.setDepthMask(!transparent);
+            pass = entryPass;
+        }
+        if (packet.program != program) {
+            packet.program->use();
+            program = packet.program;
+            stats.programChanges++;
+        }
+        if (!vertexArrayBound || packet.vertexArray != vertexArray) {
+            glState.bindVertexArray(packet.vertexArray);
+            vertexArray = packet.vertexArray;
+            vertexArrayBound = true;
+            stats.vertexArrayChanges++;
+        }
+        if (packet.texture != 0 && packet.texture != texture) {
+            glState.activeTexture(GL_TEXTURE0);
+            glState.bindTexture2D(packet.texture);
+            texture = packet.texture;
+            stats.textureChanges++;
+        }
+        if (packet.setup) packet.setup(*program, packet.data);
+
+        if (packet.instanceCount > 0) {
+            glDrawElementsInstancedBaseVertex(packet.mode, packet.indexCount, packet.indexType, (void*)packet.indexOffset,
+                packet.instanceCount, packet.baseVertex);
+        }
+        else {
+            glDrawElementsBaseVertex(packet.mode, packet.indexCount, packet.indexType, (void*)packet.indexOffset,
+                packet.baseVertex);
+        }
+        stats.draws++;
+    }
+
+    glState.setBlend(false);
+    glState.setDepthMask(true);
+    packets.clear();
+    entries.clear();
+}
@@ -0,0 +1,94 @@
+#pragma once
+// Sorted queue for the draws of the 3D pass.
+// Draws are submitted as packets during the frame and executed together at the end. Each
+// packet gets a 64-bit sort key, and the keys are radix sorted, so the order is set by the key
+// and not by the order the renderer happens to visit things in:
+//
+//   opaque:       pass | layer | program | vertex array | texture | depth (front to back)
+//   transparent:  pass | layer | depth (back to front) | program | vertex array | texture
+//
+// Opaque draws are grouped by state, and transparent draws are blended far to near. The layer
+// fixes the order of whole groups of draws within a pass where that matters more than depth
+// (batched draws have no single depth). The sort is stable, so draws with equal keys keep
+// their submission order. When executing, a program, vertex array or texture is only bound
+// when it differs from the previous packet's, and the blend and depth write state is set
+// once per pass.
+//
+// Object names are folded into 8 bits for the key. A collision only makes the grouping
+// less tight; the executor compares the real state.
+#include <glad/glad.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+
+#include "arena.h"
+#include "shader_program.h"
+#include "static_geometry.h"
+
+enum RenderPass {
+    RENDER_PASS_OPAQUE,      // No blending, depth writes on
+    RENDER_PASS_TRANSPARENT, // Alpha blending, depth writes off
+};
+
+// One indexed draw from the element buffer of its vertex array, with the state it needs
+struct DrawPacket {
+    ShaderProgram* program = nullptr;
+    GLuint vertexArray = 0;
+    GLuint texture = 0; // 2D texture on unit 0; 0 leaves whatever is bound
+
+    GLenum mode = GL_TRIANGLES;
+    GLenum indexType = GL_UNSIGNED_SHORT;
+    GLsizei indexCount = 0;
+    size_t indexOffset = 0; // In bytes
+    GLint baseVertex = 0;
+    GLsizei instanceCount = 0; // 0 draws without instancing
+
+    // Per-draw uniforms and attribute pointers, run after the program and vertex array are
+    // bound. data must outlive the queue's execute(); see RenderQueue::keep().
+    void (*setup)(ShaderProgram& program, const void* data) = nullptr;
+    const void* data = nullptr;
+};
+
+// A packet for a StaticGeometry mesh
+DrawPacket meshPacket(ShaderProgram& program, GLuint vertexArray, const MeshRange& mesh,
+    GLenum mode = GL_TRIANGLES, GLsizei instanceCount = 0);
+
+// What the last execute() drew and how much state it had to change
+struct RenderQueueStats {
+    int draws = 0;
+    int programChanges = 0;
+    int vertexArrayChanges = 0;
+    int textureChanges = 0;
+};
+
+class RenderQueue {
+public:
+    static const int MAX_LAYERS = 16;
+
+    // depth is the draw's distance from the camera as a fraction of the far plane, 0 to 1
+    void submit(RenderPass pass, int layer, float depth, const DrawPacket& packet);
+
+    // Copy a packet's setup data into the frame arena
+    template <typename T> const T* keep(const T& value) {
+        return new (frameArena.allocate<T>(1)) T(value);
+    }
+
+    // Sort and draw everything submitted, then empty the queue. Leaves blending off and
+    // depth writes on.
+    void execute(RenderQueueStats& stats);
+
+    static uint64_t sortKey(RenderPass pass, int layer, float depth, const DrawPacket& packet);
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint32_t packet;
+    };
+
+    void sortEntries();
+
+    std::vector<DrawPacket> packets;
+    std::vector<Entry> entries;
+    std::vector<Entry> scratch;
+};
@@ -0,0 +1,24 @@
+#include "rng.h"
+
+// Seeded with match seed 0 until the first match picks one
+static Pcg32 randomStreams[RANDOM_STREAM_COUNT] = {
+    Pcg32(0, RANDOM_EGG_SPAWN),
+    Pcg32(0, RANDOM_EGG_COLOR),
+    Pcg32(0, RANDOM_EFFECTS)
+};
+static uint64_t currentMatchSeed = 0;
+
+void seedRandomStreams(uint64_t matchSeed) {
+    currentMatchSeed = matchSeed;
+    for (int i = 0; i < RANDOM_STREAM_COUNT; i++) {
+        randomStreams[i].seed(matchSeed, static_cast<uint64_t>(i));
+    }
+}
+
+uint64_t randomMatchSeed() {
+    return currentMatchSeed;
+}
+
+Pcg32& randomStream(RandomStream stream) {
+    return randomStreams[stream];
+}
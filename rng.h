@@ -0,0 +1,52 @@
+#pragma once
+// Seeded random number streams for the simulation.
+// Pcg32 is the PCG-XSH-RR generator: 64 bits of state plus a stream selector, so generators
+// seeded with the same seed but different streams produce independent sequences.
+//
+// Every subsystem draws from its own stream, all derived from one match seed. Work that is
+// spread over threads (for example filling a particle burst) keys a generator per item
+// instead of sharing one, so results don't depend on which thread ran what. Reseeding with
+// the same match seed replays a match exactly.
+#include <cstdint>
+
+struct Pcg32 {
+    uint64_t state = 0x853c49e6748fea9bULL;
+    uint64_t increment = 0xda3e39cb94b95bdbULL;
+
+    Pcg32() = default;
+    Pcg32(uint64_t seed, uint64_t stream) { this->seed(seed, stream); }
+
+    void seed(uint64_t seed, uint64_t stream) {
+        state = 0;
+        increment = (stream << 1) | 1;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31));
+    }
+
+    uint64_t next64() { return (static_cast<uint64_t>(next()) << 32) | next(); }
+
+    // Uniform in [0, 1)
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+    float range(float low, float high) { return low + nextFloat() * (high - low); }
+};
+
+enum RandomStream {
+    RANDOM_EGG_SPAWN,  // Egg positions
+    RANDOM_EGG_COLOR,
+    RANDOM_EFFECTS,    // Keys for effect bursts
+    RANDOM_STREAM_COUNT
+};
+
+// Reseed every stream from a match seed
+void seedRandomStreams(uint64_t matchSeed);
+uint64_t randomMatchSeed();
+Pcg32& randomStream(RandomStream stream);
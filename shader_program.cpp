@@ -0,0 +1,156 @@
+#include "shader_program.h"
+#include "gl_state.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+
+static GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    int success;
+    char infoLog[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+        std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << infoLog << std::endl;
+    }
+
+    return shader;
+}
+
+bool ShaderProgram::create(const char* vertexSource, const char* fragmentSource) {
+    destroy();
+
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return finishLink();
+}
+
+bool ShaderProgram::createFeedback(const char* vertexSource, const char* const* varyings, int varyingCount) {
+    destroy();
+
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+
+    // Varyings have to be named before linking
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glTransformFeedbackVaryings(program, varyingCount, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    return finishLink();
+}
+
+bool ShaderProgram::finishLink() {
+
+    int success;
+    char infoLog[512];
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(program, 512, nullptr, infoLog);
+        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+
+    // Resolve every active uniform now so nothing is looked up by string while drawing
+    GLint uniformCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    uniforms.reserve(uniformCount);
+    for (GLint i = 0; i < uniformCount; i++) {
+        char name[128];
+        GLsizei length = 0;
+        GLint arraySize;
+        GLenum type;
+        glGetActiveUniform(program, static_cast<GLuint>(i), sizeof(name), &length, &arraySize, &type, name);
+
+        // Arrays are reported as "name[0]"; register them under the plain name
+        if (length > 3 && std::strcmp(name + length - 3, "[0]") == 0) {
+            name[length - 3] = '\0';
+        }
+
+        Uniform uniform;
+        uniform.hash = UniformName(name).hash;
+        uniform.location = glGetUniformLocation(program, name);
+        uniform.hasValue = false;
+        if (uniform.location >= 0) uniforms.push_back(uniform);
+    }
+
+    std::sort(uniforms.begin(), uniforms.end(), [](const Uniform& a, const Uniform& b) { return a.hash < b.hash; });
+    for (size_t i = 1; i < uniforms.size(); i++) {
+        if (uniforms[i].hash == uniforms[i - 1].hash) {
+            std::cout << "ERROR::SHADER::PROGRAM::UNIFORM_HASH_COLLISION" << std::endl;
+        }
+    }
+    return true;
+}
+
+void ShaderProgram::destroy() {
+    if (program) glDeleteProgram(program);
+    program = 0;
+    uniforms.clear();
+}
+
+void ShaderProgram::use() const {
+    glState.useProgram(program);
+}
+
+GLint ShaderProgram::location(UniformName name) const {
+    auto it = std::lower_bound(uniforms.begin(), uniforms.end(), name.hash,
+        [](const Uniform& uniform, uint32_t hash) { return uniform.hash < hash; });
+    return (it != uniforms.end() && it->hash == name.hash) ? it->location : -1;
+}
+
+void ShaderProgram::bindUniformBlock(const char* blockName, GLuint binding) {
+    GLuint index = glGetUniformBlockIndex(program, blockName);
+    if (index != GL_INVALID_INDEX) glUniformBlockBinding(program, index, binding);
+}
+
+ShaderProgram::Uniform* ShaderProgram::changed(UniformName name, const void* value, size_t size) {
+    auto it = std::lower_bound(uniforms.begin(), uniforms.end(), name.hash,
+        [](const Uniform& uniform, uint32_t hash) { return uniform.hash < hash; });
+    if (it == uniforms.end() || it->hash != name.hash) return nullptr;
+    if (it->hasValue && std::memcmp(it->value, value, size) == 0) return nullptr;
+
+    std::memcpy(it->value, value, size);
+    it->hasValue = true;
+    return &*it;
+}
+
+void ShaderProgram::setInt(UniformName name, int value) {
+    if (Uniform* uniform = changed(name, &value, sizeof(value))) glUniform1i(uniform->location, value);
+}
+
+void ShaderProgram::setFloat(UniformName name, float value) {
+    if (Uniform* uniform = changed(name, &value, sizeof(value))) glUniform1f(uniform->location, value);
+}
+
+void ShaderProgram::setVec2(UniformName name, const glm::vec2& value) {
+    if (Uniform* uniform = changed(name, &value, sizeof(value))) glUniform2fv(uniform->location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::setVec3(UniformName name, const glm::vec3& value) {
+    if (Uniform* uniform = changed(name, &value, sizeof(value))) glUniform3fv(uniform->location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::setVec4(UniformName name, const glm::vec4& value) {
+    if (Uniform* uniform = changed(name, &value, sizeof(value))) glUniform4fv(uniform->location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::setMat3(UniformName name, const glm::mat3& value) {
+    if (Uniform* uniform = changed(name, &value, sizeof(value))) glUniformMatrix3fv(uniform->location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void ShaderProgram::setMat4(UniformName name, const glm::mat4& value) {
+    if (Uniform* uniform = changed(name, &value, sizeof(value))) glUniformMatrix4fv(uniform->location, 1, GL_FALSE, glm::value_ptr(value));
+}
@@ -0,0 +1,63 @@
+#pragma once
+// Linked GL program with its uniform locations resolved once at link time.
+// Uniforms are looked up by an FNV-1a hash of their name, which the compiler folds to a constant
+// for string literals, so setUniform("view", ...) costs a short search instead of a driver call.
+// The setters remember the last value uploaded and skip the call when it hasn't changed. They
+// upload to the program currently in use, so call use() first. Names the program doesn't have
+// (or that the compiler optimised out) are ignored, like location -1 in plain GL.
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+struct UniformName {
+    uint32_t hash;
+
+    constexpr UniformName(const char* name) : hash(hashName(name, 2166136261u)) {}
+
+    static constexpr uint32_t hashName(const char* name, uint32_t hash) {
+        return *name ? hashName(name + 1, (hash ^ static_cast<unsigned char>(*name)) * 16777619u) : hash;
+    }
+};
+
+class ShaderProgram {
+public:
+    // Compile and link; errors are printed and leave the program unusable (id() == 0)
+    bool create(const char* vertexSource, const char* fragmentSource);
+
+    // Vertex-only program whose outputs are captured, interleaved, by transform feedback
+    bool createFeedback(const char* vertexSource, const char* const* varyings, int varyingCount);
+    void destroy();
+
+    void use() const; // Through glState, so binding the current program again is free
+    GLuint id() const { return program; }
+    GLint location(UniformName name) const; // -1 when the program has no such uniform
+
+    // Point a uniform block at a buffer binding; ignored when the program has no such block
+    void bindUniformBlock(const char* blockName, GLuint binding);
+
+    void setInt(UniformName name, int value);
+    void setFloat(UniformName name, float value);
+    void setVec2(UniformName name, const glm::vec2& value);
+    void setVec3(UniformName name, const glm::vec3& value);
+    void setVec4(UniformName name, const glm::vec4& value);
+    void setMat3(UniformName name, const glm::mat3& value);
+    void setMat4(UniformName name, const glm::mat4& value);
+
+private:
+    struct Uniform {
+        uint32_t hash;
+        GLint location;
+        bool hasValue;
+        unsigned char value[sizeof(glm::mat4)]; // Last value uploaded
+    };
+
+    // Check the link and resolve uniforms; on failure the program is deleted
+    bool finishLink();
+
+    // Returns the uniform when value differs from the last upload, and records it
+    Uniform* changed(UniformName name, const void* value, size_t size);
+
+    GLuint program = 0;
+    std::vector<Uniform> uniforms; // Sorted by hash
+};
@@ -0,0 +1,849 @@
+#include "simulation.h"
+#include "job_system.h"
+#include "rng.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+GameState currentGameState = GAME_START;
+
+// World boundaries
+float GROUND_SIZE = 20.0f;
+float WORLD_BOUNDARY = GROUND_SIZE / 2.0f + 1.0f; // Slightly smaller than ground for visual margin
+
+// Player properties
+glm::vec3 playerPos = glm::vec3(0.0f, 1.0f, 0.0f);
+glm::vec3 playerTargetPos = playerPos;
+float playerSpeed = 8.0f;
+float playerRadius = 0.6f;
+float playerRotation = 0.0f;
+float playerRotationTarget = 0.0f;
+bool playerAlive = true;
+float playerRespawnTimer = 0.0f;
+const float PLAYER_RESPAWN_TIME = 3.0f;
+
+EggStorage eggs;
+float eggSpawnTimer = 0.0f;
+float EGG_SPAWN_INTERVAL = 4.0f;
+const float EGG_LIFESPAN = 4.0f;
+const float EGG_RADIUS = 0.5f;
+int MAX_EGGS = 10;
+
+// Poison egg properties
+float poisonEggSpawnTimer = 0.0f;
+const float POISON_EGG_SPAWN_INTERVAL = 6.0f;
+const float POISON_EGG_LIFESPAN = 6.0f;
+const float POISON_EGG_RADIUS = 0.6f;
+int MAX_POISON_EGGS = 5;
+
+// Items per job when updating in parallel; below these counts updates run inline
+const size_t EGG_UPDATE_GRAIN = 256;
+const size_t EFFECT_UPDATE_GRAIN = 4;   // Effects carry a few dozen particles each
+const size_t TRAIL_UPDATE_GRAIN = 2048;
+const size_t PARTICLE_SPAWN_GRAIN = 512;
+
+// Egg collision broadphase
+SpatialGrid eggGrid;
+glm::vec3 playerSweepStart = glm::vec3(0.0f, 1.0f, 0.0f);
+std::vector<float> eggSweepStartX; // Egg positions before this tick's movement
+std::vector<float> eggSweepStartZ;
+
+struct EggHit {
+    uint32_t index;
+    float time;
+};
+std::vector<EggHit> eggHits;
+const float EGG_GRID_CELL_SIZE = 2.0f; // About one player plus one egg across
+const size_t EGG_GRID_MIN_EGGS = 32;    // Below this the collision pass tests every egg
+const float EGG_GRID_MAX_CELLS_PER_SIDE = 512.0f;
+std::vector<uint32_t> eggQueryResults;
+
+// Animation properties
+const float SPAWN_ANIMATION_DURATION = 1.0f;
+const float DESPAWN_ANIMATION_DURATION = 1.0f;
+const float PULSE_SPEED = 3.0f;
+const float POISON_PULSE_SPEED = 5.0f; // Faster pulse for poison eggs
+
+// Smooth damping properties
+float positionSmoothTime = 0.1f;
+float rotationSmoothTime = 0.05f;
+
+// Game state
+int score = 0;
+int lives = 3;
+
+// Fruit Ninja style miss system
+int missedEggs = 0;
+const int MAX_MISSES = 3;
+MatchVector<glm::vec3> missIndicators; // x,z for position, y for timer
+float missIndicatorDuration = 1.5f;
+
+ParticlePool effectParticles;
+const int MAX_EFFECT_BURSTS = 64; // Collection and death bursts alive at once
+
+MatchVector<CollectionEffect> collectionEffects;
+const float COLLECTION_EFFECT_DURATION = 1.2f;
+int COLLECTION_PARTICLES = 16; // More particles for better effect
+
+MatchVector<DeathEffect> deathEffects;
+const float DEATH_EFFECT_DURATION = 2.0f;
+const int DEATH_PARTICLES = 20;
+
+const float PARTICLE_GRAVITY = 9.8f; // Pulls effect particles down
+bool effectParticlesOnGpu = false;
+
+MatchVector<TrailParticle> trailParticles;
+float trailSpawnTimer = 0.0f;
+float TRAIL_SPAWN_INTERVAL = 0.05f; // Spawn trail particle every 0.05 seconds
+float TRAIL_DURATION = 1.0f; // How long trail particles last
+float TRAIL_PARTICLE_SCALE = 0.5f; // Size of trail particles
+int MAX_TRAIL_PARTICLES = 50; // Maximum number of trail particles
+
+// Timing
+float deltaTime = 0.0f;
+float simulationTime = 0.0f;
+
+// Simulation state at the start of the current tick (for render interpolation)
+glm::vec3 previousPlayerPos = glm::vec3(0.0f, 1.0f, 0.0f);
+float previousPlayerRotation = 0.0f;
+
+// Smooth damping velocities
+glm::vec3 playerPosVelocity = glm::vec3(0.0f);
+float playerRotationVelocity = 0.0f;
+
+bool simulationLogging = true;
+
+SimulationCallbacks simulationCallbacks = { nullptr, nullptr, nullptr, nullptr, nullptr };
+
+// Boundary checking function
+void enforceWorldBoundaries(glm::vec3& position) {
+    float boundary = WORLD_BOUNDARY - playerRadius;
+    // X boundary
+    position.x = glm::clamp(position.x, -boundary, boundary);
+
+    // Z boundary 
+    position.z = glm::clamp(position.z, -boundary, boundary);
+
+    // Y boundary (ground collision)
+    position.y = glm::max(position.y, playerRadius);
+}
+
+// Smooth damping functions
+glm::vec3 smoothDamp(glm::vec3 current, glm::vec3 target, glm::vec3& currentVelocity, float smoothTime, float deltaTime) {
+    float omega = 2.0f / smoothTime;
+    float x = omega * deltaTime;
+    float exp = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
+
+    glm::vec3 change = current - target;
+    glm::vec3 temp = (currentVelocity + omega * change) * deltaTime;
+    currentVelocity = (currentVelocity - omega * temp) * exp;
+    glm::vec3 output = target + (change + temp) * exp;
+
+    return output;
+}
+
+float smoothDamp(float current, float target, float& currentVelocity, float smoothTime, float deltaTime) {
+    float omega = 2.0f / smoothTime;
+    float x = omega * deltaTime;
+    float exp = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
+
+    float change = current - target;
+    float temp = (currentVelocity + omega * change) * deltaTime;
+    currentVelocity = (currentVelocity - omega * temp) * exp;
+    float output = target + (change + temp) * exp;
+
+    return output;
+}
+
+// Continuous collision between two spheres moving linearly over one tick.
+// Returns true if they come within radius of each other, with hitTime in [0, 1] being the
+// fraction of the tick at which they first touch (0 if they already overlap at the start).
+bool sweepSpheres(const glm::vec3& startA, const glm::vec3& endA, const glm::vec3& startB, const glm::vec3& endB,
+    float radius, float& hitTime) {
+    // Work in B's frame: A moves from offset to offset + motion
+    glm::vec3 offset = startA - startB;
+    glm::vec3 motion = (endA - startA) - (endB - startB);
+
+    float c = glm::dot(offset, offset) - radius * radius;
+    if (c < 0.0f) {
+        hitTime = 0.0f;
+        return true;
+    }
+
+    float a = glm::dot(motion, motion);
+    float b = glm::dot(offset, motion);
+    if (a < 1e-8f || b >= 0.0f) return false; // Not moving relative to each other, or moving apart
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return false;
+
+    float t = (-b - sqrtf(discriminant)) / a;
+    if (t > 1.0f) return false;
+
+    hitTime = t;
+    return true;
+}
+
+// Generate random position for eggs
+glm::vec3 generateRandomEggPosition() {
+    float boundary = WORLD_BOUNDARY - EGG_RADIUS - 1.0f; // Keep eggs away from edges
+    Pcg32& random = randomStream(RANDOM_EGG_SPAWN);
+    float x = random.range(-boundary, boundary);
+    float z = random.range(-boundary, boundary);
+    return glm::vec3(x, EGG_RADIUS, z);
+}
+
+// Generate random color for eggs
+glm::vec3 generateRandomEggColor() {
+    Pcg32& random = randomStream(RANDOM_EGG_COLOR);
+    float r = random.range(0.5f, 1.0f);
+    float g = random.range(0.5f, 1.0f);
+    float b = random.range(0.5f, 1.0f);
+    return glm::vec3(r, g, b);
+}
+
+// Spawn a new egg
+void spawnEgg() {
+    // Only spawn if we have room for more eggs and game is active
+    if (eggs.regularCount() < MAX_EGGS && currentGameState == GAME_PLAYING) {
+        glm::vec3 position = generateRandomEggPosition();
+
+        // Regular eggs don't chase; their AI properties stay zeroed
+        eggs.add(position, EGG_RADIUS, generateRandomEggColor(), simulationTime, EGG_LIFESPAN, false, 0.0f, 0.0f);
+        if (simulationLogging) std::cout << "Egg spawned at (" << position.x << ", " << position.z << ")" << std::endl;
+    }
+}
+
+// Spawn a poison egg
+void spawnPoisonEgg() {
+    if (eggs.poisonCount() < MAX_POISON_EGGS && currentGameState == GAME_PLAYING) {
+        glm::vec3 position = generateRandomEggPosition();
+
+        // Chase speed 3 (adjust for difficulty), start chasing after 1 second
+        eggs.add(position, POISON_EGG_RADIUS, glm::vec3(0.6f, 0.2f, 0.8f), simulationTime, POISON_EGG_LIFESPAN, true, 3.0f, 1.0f);
+        if (simulationLogging) std::cout << "POISON EGG spawned at (" << position.x << ", " << position.z << ")" << std::endl;
+    }
+}
+
+// Size the effect particle pool and clear all bursts
+void initEffects() {
+    // One block fits the larger burst, rounded up to whole AVX vectors
+    const uint32_t blockSize = static_cast<uint32_t>((std::max(COLLECTION_PARTICLES, DEATH_PARTICLES) + 7) / 8 * 8);
+    if (effectParticles.blockCount() == MAX_EFFECT_BURSTS && effectParticles.blockSize() == blockSize) {
+        effectParticles.releaseAll();
+    }
+    else {
+        effectParticles.init(MAX_EFFECT_BURSTS, blockSize);
+    }
+
+    collectionEffects.clear();
+    deathEffects.clear();
+    collectionEffects.reserve(MAX_EFFECT_BURSTS);
+    deathEffects.reserve(MAX_EFFECT_BURSTS);
+}
+
+// Enhanced collection effect creation (Fruit Ninja style)
+void createCollectionEffect(const glm::vec3& position, const glm::vec3& color) {
+    if (simulationCallbacks.onCollectionEffect) simulationCallbacks.onCollectionEffect(position);
+    if (effectParticles.blockCount() == 0) initEffects();
+
+    CollectionEffect effect;
+    if (!effectParticles.allocate(effect.firstParticle)) {
+        if (simulationLogging) std::cout << "Effect pool full, collection effect skipped" << std::endl;
+        return;
+    }
+    // The pool is only resized between matches, so clamp in case the limit changed mid-match
+    effect.particleCount = std::min(static_cast<uint32_t>(COLLECTION_PARTICLES), effectParticles.blockSize());
+    effect.position = position;
+    effect.color = color;
+    effect.timer = COLLECTION_EFFECT_DURATION;
+    effect.duration = COLLECTION_EFFECT_DURATION;
+    effect.active = true;
+
+    // Create particles for burst effect - Fruit Ninja style.
+    // Each particle gets its own generator keyed by the burst, so any split over threads
+    // produces the same burst.
+    const uint64_t burstKey = randomStream(RANDOM_EFFECTS).next64();
+    parallelFor(effect.particleCount, PARTICLE_SPAWN_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Pcg32 random(burstKey, i);
+
+            // Random direction in a more controlled burst pattern
+            float angle = (float)i / effect.particleCount * 2.0f * 3.14159f;
+            float spread = random.range(0.3f, 1.0f);
+            float speed = random.range(3.0f, 7.0f);
+
+            glm::vec3 velocity;
+            velocity.x = cos(angle) * speed * spread;
+            velocity.y = random.range(1.5f, 4.5f); // More upward velocity
+            velocity.z = sin(angle) * speed * spread;
+
+            // Random particle size (like fruit chunks in Fruit Ninja)
+            glm::vec3 size;
+            size.x = random.range(0.1f, 0.3f);
+            size.y = random.range(0.1f, 0.3f);
+            size.z = random.range(0.1f, 0.3f);
+
+            uint32_t particle = effect.firstParticle + static_cast<uint32_t>(i);
+            effectParticles.set(particle, position, velocity);
+            effectParticles.size[particle] = size;
+            effectParticles.color[particle] = color;
+            effectParticles.rotation[particle] = random.range(0.0f, 6.28318f);
+            effectParticles.rotationSpeed[particle] = random.range(-5.0f, 5.0f);
+        }
+    });
+
+    collectionEffects.push_back(effect);
+    if (simulationLogging) std::cout << "Collection effect created at (" << position.x << ", " << position.z << ")" << std::endl;
+}
+
+// Enhanced death effect creation
+void createDeathEffect(const glm::vec3& position) {
+    if (simulationCallbacks.onDeathEffect) simulationCallbacks.onDeathEffect(position);
+    if (effectParticles.blockCount() == 0) initEffects();
+
+    DeathEffect effect;
+    if (!effectParticles.allocate(effect.firstParticle)) {
+        if (simulationLogging) std::cout << "Effect pool full, death effect skipped" << std::endl;
+        return;
+    }
+    effect.particleCount = static_cast<uint32_t>(DEATH_PARTICLES);
+    effect.position = position;
+    effect.timer = DEATH_EFFECT_DURATION;
+    effect.duration = DEATH_EFFECT_DURATION;
+    effect.active = true;
+
+    // Create particles for death explosion, one generator per particle as for collections
+    const uint64_t burstKey = randomStream(RANDOM_EFFECTS).next64();
+    parallelFor(effect.particleCount, PARTICLE_SPAWN_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Pcg32 random(burstKey, i);
+
+            // Random spherical direction for explosion
+            float theta = random.range(0.0f, 2.0f * 3.14159f);
+            float phi = acos(random.range(-1.0f, 1.0f));
+            float speed = random.range(3.0f, 7.0f);
+
+            glm::vec3 velocity = glm::vec3(
+                sin(phi) * cos(theta) * speed,
+                sin(phi) * sin(theta) * speed,
+                cos(phi) * speed
+            );
+
+            // Random particle size
+            glm::vec3 size;
+            size.x = random.range(0.15f, 0.4f);
+            size.y = random.range(0.15f, 0.4f);
+            size.z = random.range(0.15f, 0.4f);
+
+            // Purple color with some variation
+            glm::vec3 particleColor;
+            particleColor.x = random.range(0.6f, 0.9f);
+            particleColor.y = random.range(0.1f, 0.3f);
+            particleColor.z = random.range(0.7f, 0.9f);
+
+            uint32_t particle = effect.firstParticle + static_cast<uint32_t>(i);
+            effectParticles.set(particle, position, velocity);
+            effectParticles.size[particle] = size;
+            effectParticles.color[particle] = particleColor;
+            effectParticles.rotation[particle] = 0.0f;
+            effectParticles.rotationSpeed[particle] = 0.0f;
+        }
+    });
+
+    deathEffects.push_back(effect);
+    if (simulationLogging) std::cout << "Death effect created at (" << position.x << ", " << position.z << ")" << std::endl;
+}
+
+// Update collection effects
+void updateCollectionEffects() {
+    // Effects are independent of each other, so they integrate in parallel
+    parallelFor(collectionEffects.size(), EFFECT_UPDATE_GRAIN, [](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; e++) {
+            CollectionEffect& effect = collectionEffects[e];
+            if (!effect.active) continue;
+
+            effect.timer -= deltaTime;
+
+            // Update particle positions (with gravity) and rotations
+            if (!effectParticlesOnGpu) {
+                effectParticles.integrate(effect.firstParticle, effect.particleCount, PARTICLE_GRAVITY, deltaTime);
+                effectParticles.advanceRotation(effect.firstParticle, effect.particleCount, deltaTime);
+            }
+
+            // Deactivate when timer expires
+            if (effect.timer <= 0.0f) {
+                effect.active = false;
+            }
+        }
+    });
+
+    // Return finished bursts to the pool, then drop their records
+    for (const auto& effect : collectionEffects) {
+        if (!effect.active) effectParticles.release(effect.firstParticle);
+    }
+    collectionEffects.erase(std::remove_if(collectionEffects.begin(), collectionEffects.end(),
+        [](const CollectionEffect& effect) { return !effect.active; }), collectionEffects.end());
+}
+
+// Update death effects
+void updateDeathEffects() {
+    parallelFor(deathEffects.size(), EFFECT_UPDATE_GRAIN, [](size_t begin, size_t end) {
+        for (size_t e = begin; e < end; e++) {
+            DeathEffect& effect = deathEffects[e];
+            if (!effect.active) continue;
+
+            effect.timer -= deltaTime;
+
+            // Update particle positions (with gravity)
+            if (!effectParticlesOnGpu) {
+                effectParticles.integrate(effect.firstParticle, effect.particleCount, PARTICLE_GRAVITY, deltaTime);
+            }
+
+            // Deactivate when timer expires
+            if (effect.timer <= 0.0f) {
+                effect.active = false;
+            }
+        }
+    });
+
+    // Return finished bursts to the pool, then drop their records
+    for (const auto& effect : deathEffects) {
+        if (!effect.active) effectParticles.release(effect.firstParticle);
+    }
+    deathEffects.erase(std::remove_if(deathEffects.begin(), deathEffects.end(),
+        [](const DeathEffect& effect) { return !effect.active; }), deathEffects.end());
+}
+
+// Update trail effects
+void updateTrailEffects() {
+    // Only update trails during gameplay
+    if (currentGameState != GAME_PLAYING) return;
+
+    // Age existing trail particles in parallel, then drop expired ones in a single ordered pass
+    parallelFor(trailParticles.size(), TRAIL_UPDATE_GRAIN, [](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            trailParticles[i].timer -= deltaTime;
+        }
+    });
+    trailParticles.erase(std::remove_if(trailParticles.begin(), trailParticles.end(),
+        [](const TrailParticle& particle) { return particle.timer <= 0.0f; }), trailParticles.end());
+
+    // Spawn new trail particles when player is moving and alive
+    if (playerAlive) {
+        trailSpawnTimer += deltaTime;
+
+        // Check if player is actually moving (position changed)
+        static glm::vec3 lastPlayerPos = playerPos;
+        bool isMoving = glm::distance(playerPos, lastPlayerPos) > 0.01f;
+        lastPlayerPos = playerPos;
+
+        if (isMoving && trailSpawnTimer >= TRAIL_SPAWN_INTERVAL) {
+            // Remove oldest particle if we're at the limit
+            if (trailParticles.size() >= static_cast<size_t>(MAX_TRAIL_PARTICLES)) {
+                trailParticles.erase(trailParticles.begin());
+            }
+
+            TrailParticle newParticle;
+            newParticle.position = playerPos - glm::vec3(0.0f, playerRadius * 0.5f, 0.0f); // Position below player
+            newParticle.color = glm::vec3(0.8f, 0.2f, 0.2f); // Red color matching player
+            newParticle.timer = TRAIL_DURATION;
+            newParticle.duration = TRAIL_DURATION;
+            newParticle.scale = TRAIL_PARTICLE_SCALE;
+
+            trailParticles.push_back(newParticle);
+            trailSpawnTimer = 0.0f;
+        }
+    }
+}
+
+// Player death function
+void killPlayer() {
+    if (playerAlive) {
+        playerAlive = false;
+        lives--;
+        playerRespawnTimer = PLAYER_RESPAWN_TIME;
+
+        // Trigger screen shake effect
+        if (simulationCallbacks.onPlayerKilled) simulationCallbacks.onPlayerKilled();
+
+        // Check for game over due to no lives
+        if (lives <= 0) {
+            currentGameState = GAME_OVER;
+
+            // Stop screen shake, check for a new high score and save the profile
+            if (simulationCallbacks.onGameOver) simulationCallbacks.onGameOver(GAME_OVER_NO_LIVES);
+            if (simulationLogging) std::cout << "GAME OVER! Final Score: " << score << std::endl;
+            if (simulationLogging) std::cout << "Reason: No lives remaining!" << std::endl;
+        }
+        else {
+            if (simulationLogging) std::cout << "Player died! Lives remaining: " << lives << std::endl;
+        }
+    }
+}
+
+// Respawn player
+void respawnPlayer() {
+    playerPos = glm::vec3(0.0f, 1.0f, 0.0f);
+    playerTargetPos = playerPos;
+    previousPlayerPos = playerPos; // Teleport, don't interpolate from the death position
+    playerSweepStart = playerPos;  // ...and don't sweep collisions across the jump either
+    playerAlive = true;
+    if (simulationLogging) std::cout << "Player respawned!" << std::endl;
+}
+
+// Check for missed eggs (Fruit Ninja style)
+// In the checkForMissedEggs() function, update the game over condition:
+void checkForMissedEggs() {
+    for (size_t i = 0; i < eggs.size(); ) {
+        if (!eggs.isPoison(i) && eggs.lifeTimer[i] <= 0.0f) {
+            glm::vec3 position = eggs.position(i);
+            if (simulationCallbacks.onEggMissed) simulationCallbacks.onEggMissed(position);
+            // Egg expired without being collected - this is a miss!
+            missedEggs++;
+
+            // Add miss indicator at egg position (world space)
+            glm::vec3 missIndicator = glm::vec3(position.x, missIndicatorDuration, position.z);
+            missIndicators.push_back(missIndicator);
+
+            if (simulationLogging) std::cout << "Missed egg! Misses: " << missedEggs << "/" << MAX_MISSES << std::endl;
+
+            // Check for game over due to too many misses (once, however many eggs expire together)
+            if (missedEggs >= MAX_MISSES && currentGameState != GAME_OVER) {
+                currentGameState = GAME_OVER;
+
+                // Stop any active screen shake effect and check for a new high score
+                if (simulationCallbacks.onGameOver) simulationCallbacks.onGameOver(GAME_OVER_TOO_MANY_MISSES);
+                if (simulationLogging) std::cout << "GAME OVER! Too many missed eggs! Final Score: " << score << std::endl;
+            }
+
+            // Remove the expired egg (the last egg moves into slot i, so look at i again)
+            eggs.remove(i);
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+// Update miss indicators
+void updateMissIndicators() {
+    // Remove expired miss indicators
+    missIndicators.erase(std::remove_if(missIndicators.begin(), missIndicators.end(),
+        [](const glm::vec3& indicator) {
+            return indicator.y <= 0.0f; // Use y component as timer
+        }), missIndicators.end());
+
+    // Update timers for active indicators
+    for (auto& indicator : missIndicators) {
+        indicator.y -= deltaTime; // Decrease timer (stored in y component)
+    }
+}
+
+// Update egg animations and lifecycle
+void updateEggs() {
+    // Don't update eggs if game is not playing
+    if (currentGameState != GAME_PLAYING) return;
+
+    // Update spawn timers
+    eggSpawnTimer += deltaTime;
+    poisonEggSpawnTimer += deltaTime;
+
+    // Spawn new egg if timer reaches interval; stress intervals shorter than a tick spawn
+    // several at once
+    if (eggSpawnTimer >= EGG_SPAWN_INTERVAL) {
+        int spawnCount = std::min(static_cast<int>(eggSpawnTimer / EGG_SPAWN_INTERVAL),
+            MAX_EGGS - static_cast<int>(eggs.regularCount()));
+        for (int i = 0; i < std::max(spawnCount, 1); i++) {
+            spawnEgg();
+        }
+        eggSpawnTimer = 0.0f;
+    }
+
+    // Spawn poison egg if timer reaches interval
+    if (poisonEggSpawnTimer >= POISON_EGG_SPAWN_INTERVAL) {
+        spawnPoisonEgg();
+        poisonEggSpawnTimer = 0.0f;
+    }
+
+    // The pulse and bobbing only depend on time and egg type
+    const float regularPulse = sin(simulationTime * PULSE_SPEED) * 0.1f + 1.0f; // Pulse between 0.9 and 1.1
+    const float poisonPulse = sin(simulationTime * POISON_PULSE_SPEED) * 0.1f + 1.0f;
+    const float bobHeight = EGG_RADIUS + sin(simulationTime * 8.0f) * 0.1f;
+
+    // Update all eggs. Each egg only touches its own entries, so chunks run on the job system.
+    eggSweepStartX.assign(eggs.positionX.begin(), eggs.positionX.end());
+    eggSweepStartZ.assign(eggs.positionZ.begin(), eggs.positionZ.end());
+    parallelFor(eggs.size(), EGG_UPDATE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            unsigned char flags = eggs.flags[i];
+
+            const bool poison = (flags & EGG_POISON) != 0;
+            const float lifespan = poison ? POISON_EGG_LIFESPAN : EGG_LIFESPAN;
+
+            // Update life timer
+            float lifeTimer = eggs.lifeTimer[i] - deltaTime;
+            eggs.lifeTimer[i] = lifeTimer;
+
+            // AI CHASING BEHAVIOR FOR POISON EGGS
+            if (poison && playerAlive && currentGameState == GAME_PLAYING) {
+                // Start chasing after initial delay and if spawn animation is complete
+                if (!(flags & EGG_SPAWNING) && lifeTimer < (POISON_EGG_LIFESPAN - eggs.chaseStartTime[i])) {
+                    flags |= EGG_CHASING;
+
+                    // Calculate direction to player (kept on the horizontal plane)
+                    float directionX = playerPos.x - eggs.positionX[i];
+                    float directionZ = playerPos.z - eggs.positionZ[i];
+                    float length = sqrtf(directionX * directionX + directionZ * directionZ);
+
+                    // Normalize direction and apply speed
+                    if (length > 0.1f) {
+                        float speed = eggs.chaseSpeed[i] / length;
+                        eggs.velocityX[i] = directionX * speed;
+                        eggs.velocityZ[i] = directionZ * speed;
+
+                        // Update position with velocity
+                        eggs.positionX[i] += eggs.velocityX[i] * deltaTime;
+                        eggs.positionZ[i] += eggs.velocityZ[i] * deltaTime;
+
+                        // Optional: Add some vertical bobbing for visual effect
+                        eggs.positionY[i] = bobHeight;
+                    }
+                }
+                else if (flags & EGG_SPAWNING) {
+                    // Reset velocity during spawn animation
+                    eggs.velocityX[i] = 0.0f;
+                    eggs.velocityZ[i] = 0.0f;
+                    flags &= ~EGG_CHASING;
+                }
+            }
+
+            // Update pulse animation (continuous pulsing)
+            eggs.pulseFactor[i] = poison ? poisonPulse : regularPulse;
+
+            // Handle spawn animation
+            if (flags & EGG_SPAWNING) {
+                float spawnProgress = 1.0f - (lifeTimer / lifespan);
+                float spawnDuration = poison ? SPAWN_ANIMATION_DURATION * 0.7f : SPAWN_ANIMATION_DURATION;
+                if (spawnProgress < spawnDuration / lifespan) {
+                    // Scale up during spawn animation
+                    eggs.scale[i] = spawnProgress * (lifespan / spawnDuration);
+                }
+                else {
+                    // Spawn animation complete
+                    eggs.scale[i] = 1.0f;
+                    flags &= ~EGG_SPAWNING;
+                }
+            }
+
+            // Handle despawn animation
+            float despawnDuration = poison ? DESPAWN_ANIMATION_DURATION * 0.7f : DESPAWN_ANIMATION_DURATION;
+            if (lifeTimer <= despawnDuration && !(flags & EGG_DESPAWNING)) {
+                flags |= EGG_DESPAWNING;
+                // Stop chasing when despawning starts
+                if (poison) {
+                    flags &= ~EGG_CHASING;
+                    eggs.velocityX[i] = 0.0f;
+                    eggs.velocityZ[i] = 0.0f;
+                }
+            }
+
+            if (flags & EGG_DESPAWNING) {
+                // Scale down during despawn animation
+                float despawnProgress = lifeTimer / despawnDuration;
+                eggs.scale[i] = despawnProgress;
+            }
+
+            eggs.flags[i] = flags;
+        }
+    });
+
+    // Collision reach: largest egg, and farthest any egg moved this tick
+    float maxCollisionRadius = 0.0f;
+    float maxEggTravelSquared = 0.0f;
+    for (size_t i = 0; i < eggs.size(); i++) {
+        maxCollisionRadius = std::max(maxCollisionRadius, eggs.radius[i] * eggs.scale[i]);
+        float dx = eggs.positionX[i] - eggSweepStartX[i];
+        float dz = eggs.positionZ[i] - eggSweepStartZ[i];
+        maxEggTravelSquared = std::max(maxEggTravelSquared, dx * dx + dz * dz);
+    }
+    const float maxEggTravel = sqrtf(maxEggTravelSquared);
+
+    // Check for collisions with player (only if player is alive). Both the player and the
+    // chasing eggs are swept from where they were last tick, so nothing is skipped over when
+    // the tick rate is low or the player is fast.
+    if (playerAlive) {
+        const glm::vec3 playerSweepEnd = playerPos;
+        const glm::vec3 sweepCenter = (playerSweepStart + playerSweepEnd) * 0.5f;
+        const float sweepReach = glm::distance(playerSweepStart, playerSweepEnd) * 0.5f + playerRadius +
+            maxCollisionRadius + maxEggTravel;
+
+        // Broadphase: only eggs in grid cells near the player's path can touch it. With just a
+        // few eggs around, testing them all is cheaper than rebuilding the grid.
+        eggQueryResults.clear();
+        if (eggs.size() >= EGG_GRID_MIN_EGGS) {
+            buildEggGrid();
+            eggGrid.queryRadius(sweepCenter.x, sweepCenter.z, sweepReach, eggQueryResults);
+        }
+        else {
+            for (size_t i = 0; i < eggs.size(); i++) {
+                eggQueryResults.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        eggHits.clear();
+        for (uint32_t i : eggQueryResults) {
+            glm::vec3 eggEnd = eggs.position(i);
+            glm::vec3 eggStart = glm::vec3(eggSweepStartX[i], eggEnd.y, eggSweepStartZ[i]);
+            float collisionDistance = playerRadius + eggs.radius[i] * eggs.scale[i];
+
+            EggHit hit;
+            hit.index = i;
+            if (sweepSpheres(playerSweepStart, playerSweepEnd, eggStart, eggEnd, collisionDistance, hit.time)) {
+                eggHits.push_back(hit);
+            }
+        }
+
+        // Resolve hits in the order they happened during the tick
+        std::sort(eggHits.begin(), eggHits.end(), [](const EggHit& a, const EggHit& b) {
+            return a.time < b.time || (a.time == b.time && a.index < b.index);
+        });
+
+        eggQueryResults.clear();
+        for (const EggHit& hit : eggHits) {
+            // A poison egg kills the player, after which nothing else can be hit this tick
+            if (!playerAlive) break;
+
+            const uint32_t i = hit.index;
+            glm::vec3 position = glm::mix(glm::vec3(eggSweepStartX[i], eggs.positionY[i], eggSweepStartZ[i]),
+                eggs.position(i), hit.time);
+
+            if (eggs.isPoison(i)) {
+                //playPoisonSound();
+                // Poison egg - kill player immediately
+                createDeathEffect(position); // Add death effect
+                killPlayer();
+                if (simulationLogging) std::cout << "Player hit poison egg! Lives: " << lives << std::endl;
+            }
+            else {
+                // Regular egg - collect and score
+                createCollectionEffect(position, eggs.color[i]); // Add collection effect
+                score += 10;
+                if (simulationLogging) std::cout << "Egg collected! Score: " << score << std::endl;
+            }
+            eggQueryResults.push_back(i);
+        }
+
+        // Remove hit eggs from the highest index down so the pending indices stay valid
+        std::sort(eggQueryResults.begin(), eggQueryResults.end());
+        while (!eggQueryResults.empty()) {
+            eggs.remove(eggQueryResults.back());
+            eggQueryResults.pop_back();
+        }
+    }
+    playerSweepStart = playerPos;
+
+    // Remove poison eggs if lifespan is over (regular eggs are handled in checkForMissedEggs).
+    // Removing an egg moves the last one into its index, which is then visited next.
+    for (size_t i = 0; i < eggs.size(); ) {
+        if (eggs.isPoison(i) && eggs.lifeTimer[i] <= 0.0f) {
+            eggs.remove(i);
+            if (simulationLogging) std::cout << "Poison egg despawned!" << std::endl;
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+void buildEggGrid() {
+    // Huge stress arenas use coarser cells so clearing the grid stays cheap
+    const float worldSize = WORLD_BOUNDARY * 2.0f;
+    eggGrid.configure(worldSize, std::max(EGG_GRID_CELL_SIZE, worldSize / EGG_GRID_MAX_CELLS_PER_SIDE));
+    eggGrid.build(eggs.positionX.data(), eggs.positionZ.data(), eggs.size());
+}
+
+// Update player respawn
+void updatePlayer() {
+    if (currentGameState != GAME_PLAYING) return; // Don't update player if game not playing
+
+    if (!playerAlive && currentGameState == GAME_PLAYING) {
+        playerRespawnTimer -= deltaTime;
+        if (playerRespawnTimer <= 0.0f) {
+            respawnPlayer();
+        }
+    }
+}
+
+void saveSimulationState() {
+    previousPlayerPos = playerPos;
+    previousPlayerRotation = playerRotation;
+    eggs.savePositions();
+}
+
+void stepSimulation(float dt) {
+    deltaTime = dt;
+    simulationTime += deltaTime;
+
+    // Update egg system
+    updateEggs();
+
+    // Check for missed eggs (Fruit Ninja style) - MUST be called AFTER updateEggs
+    checkForMissedEggs();
+
+    // Update miss indicators
+    updateMissIndicators();
+
+    // Update effect systems
+    updateCollectionEffects();
+    updateDeathEffects();
+    updateTrailEffects(); // Update trail effects
+
+    // Update player respawn
+    updatePlayer();
+
+    // Apply smooth damping to player position (only if alive)
+    if (playerAlive) {
+        playerPos = smoothDamp(playerPos, playerTargetPos, playerPosVelocity, positionSmoothTime, deltaTime);
+        playerRotation = smoothDamp(playerRotation, playerRotationTarget, playerRotationVelocity, rotationSmoothTime, deltaTime);
+    }
+}
+
+// Drop every per-match container at once, start the match arena over and reserve each
+// container at its cap so the match itself never has to grow one
+static void resetMatchContainers() {
+    MatchVector<glm::vec3>().swap(missIndicators);
+    MatchVector<CollectionEffect>().swap(collectionEffects);
+    MatchVector<DeathEffect>().swap(deathEffects);
+    MatchVector<TrailParticle>().swap(trailParticles);
+    matchArena.reset();
+
+    // Indicators outlive the miss count, and every egg on the field can expire at once
+    missIndicators.reserve(static_cast<size_t>(MAX_EGGS) + MAX_POISON_EGGS);
+    trailParticles.reserve(MAX_TRAIL_PARTICLES);
+    initEffects(); // Reserves the effect lists
+}
+
+void resetSimulation() {
+    score = 0;
+    lives = 3;
+    missedEggs = 0;
+    playerAlive = true;
+    eggs.clear();
+    eggs.reserve(static_cast<size_t>(MAX_EGGS) + MAX_POISON_EGGS);
+    resetMatchContainers();
+    playerPos = glm::vec3(0.0f, 1.0f, 0.0f);
+    playerTargetPos = playerPos;
+    previousPlayerPos = playerPos;
+    playerPosVelocity = glm::vec3(0.0f);
+    playerRotation = 0.0f;
+    playerRotationTarget = 0.0f;
+    previousPlayerRotation = 0.0f;
+    playerSweepStart = playerPos;
+    playerRotationVelocity = 0.0f;
+    eggSpawnTimer = 0.0f;
+    poisonEggSpawnTimer = 0.0f;
+    playerRespawnTimer = 0.0f;
+    trailSpawnTimer = 0.0f; // Reset trail timer
+}
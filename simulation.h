@@ -0,0 +1,194 @@
+#pragma once
+// Gameplay simulation: eggs, player, effects and match rules.
+// Has no windowing, audio or GL dependency so it can also be driven headless.
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "egg_storage.h"
+#include "spatial_grid.h"
+#include "particle_pool.h"
+#include "arena.h"
+
+// Game states
+enum GameState {
+    GAME_START,
+    GAME_PLAYING,
+    GAME_PAUSED,
+    GAME_OVER
+};
+
+// Why a match ended
+enum GameOverReason {
+    GAME_OVER_NO_LIVES,
+    GAME_OVER_TOO_MANY_MISSES
+};
+
+extern GameState currentGameState;
+
+// World boundaries. Set GROUND_SIZE through applyStressConfig() so WORLD_BOUNDARY follows.
+extern float GROUND_SIZE;
+extern float WORLD_BOUNDARY;
+
+// Player properties
+extern glm::vec3 playerPos;
+extern glm::vec3 playerTargetPos;
+extern float playerSpeed;
+extern float playerRadius;
+extern float playerRotation;
+extern float playerRotationTarget;
+extern bool playerAlive;
+extern float playerRespawnTimer;
+extern const float PLAYER_RESPAWN_TIME;
+
+// Egg properties
+extern EggStorage eggs;
+extern float eggSpawnTimer;
+extern float EGG_SPAWN_INTERVAL;
+extern const float EGG_LIFESPAN;
+extern const float EGG_RADIUS;
+extern int MAX_EGGS;
+
+// Poison egg properties
+extern float poisonEggSpawnTimer;
+extern const float POISON_EGG_SPAWN_INTERVAL;
+extern const float POISON_EGG_LIFESPAN;
+extern const float POISON_EGG_RADIUS;
+extern int MAX_POISON_EGGS;
+
+// Egg collision broadphase. Ids are dense egg indices. The collision pass only rebuilds it once
+// there are enough eggs to be worth it, so callers querying it run buildEggGrid() first.
+extern SpatialGrid eggGrid;
+extern const float EGG_GRID_CELL_SIZE;
+extern const size_t EGG_GRID_MIN_EGGS;
+extern const float EGG_GRID_MAX_CELLS_PER_SIDE;
+
+// Player position at the previous collision pass; collisions are swept from here
+extern glm::vec3 playerSweepStart;
+
+// Smooth damping properties
+extern float positionSmoothTime;
+extern float rotationSmoothTime;
+
+// Game state
+extern int score;
+extern int lives;
+
+// Fruit Ninja style miss system
+extern int missedEggs;
+extern const int MAX_MISSES;
+extern MatchVector<glm::vec3> missIndicators; // x,z for position, y for timer
+extern float missIndicatorDuration;
+
+// Effect particles. Every burst owns one block of this pool (firstParticle onwards).
+extern ParticlePool effectParticles;
+extern const int MAX_EFFECT_BURSTS;
+
+// Enhanced collection effect properties (Fruit Ninja style)
+struct CollectionEffect {
+    glm::vec3 position;
+    glm::vec3 color;
+    float timer;
+    float duration;
+    bool active;
+    uint32_t firstParticle;
+    uint32_t particleCount;
+};
+
+extern MatchVector<CollectionEffect> collectionEffects;
+extern const float COLLECTION_EFFECT_DURATION;
+extern int COLLECTION_PARTICLES;
+
+// Enhanced death effect
+struct DeathEffect {
+    glm::vec3 position;
+    float timer;
+    float duration;
+    bool active;
+    uint32_t firstParticle; // Particle colors are kept per particle in the pool
+    uint32_t particleCount;
+};
+
+extern MatchVector<DeathEffect> deathEffects;
+extern const float DEATH_EFFECT_DURATION;
+extern const int DEATH_PARTICLES;
+
+extern const float PARTICLE_GRAVITY;
+
+// The renderer moves effect particles on the GPU; the simulation only ages the bursts and the
+// pool keeps each burst's spawn state
+extern bool effectParticlesOnGpu;
+
+// Trail effect properties
+struct TrailParticle {
+    glm::vec3 position;
+    glm::vec3 color;
+    float timer;
+    float duration;
+    float scale;
+};
+
+extern MatchVector<TrailParticle> trailParticles;
+extern float trailSpawnTimer;
+extern float TRAIL_SPAWN_INTERVAL;
+extern float TRAIL_DURATION;
+extern float TRAIL_PARTICLE_SCALE;
+extern int MAX_TRAIL_PARTICLES;
+
+// Timing
+extern float deltaTime;
+extern float simulationTime; // Advances only while the simulation is ticking
+
+// Simulation state at the start of the current tick (for render interpolation)
+extern glm::vec3 previousPlayerPos;
+extern float previousPlayerRotation;
+
+// Smooth damping velocities
+extern glm::vec3 playerPosVelocity;
+extern float playerRotationVelocity;
+
+// Print gameplay events to the console (the headless driver turns this off)
+extern bool simulationLogging;
+
+// Hooks for presentation side effects (sounds, screen shake, high scores).
+// Any of them may be left null.
+struct SimulationCallbacks {
+    void (*onCollectionEffect)(const glm::vec3& position);
+    void (*onDeathEffect)(const glm::vec3& position);
+    void (*onEggMissed)(const glm::vec3& position);
+    void (*onPlayerKilled)();
+    void (*onGameOver)(GameOverReason reason);
+};
+
+extern SimulationCallbacks simulationCallbacks;
+
+void enforceWorldBoundaries(glm::vec3& position);
+glm::vec3 smoothDamp(glm::vec3 current, glm::vec3 target, glm::vec3& currentVelocity, float smoothTime, float deltaTime);
+float smoothDamp(float current, float target, float& currentVelocity, float smoothTime, float deltaTime);
+bool sweepSpheres(const glm::vec3& startA, const glm::vec3& endA, const glm::vec3& startB, const glm::vec3& endB,
+    float radius, float& hitTime);
+
+void spawnEgg();
+void spawnPoisonEgg();
+void initEffects();
+void createCollectionEffect(const glm::vec3& position, const glm::vec3& color);
+void createDeathEffect(const glm::vec3& position);
+void updateCollectionEffects();
+void updateDeathEffects();
+void updateTrailEffects();
+void killPlayer();
+void respawnPlayer();
+void checkForMissedEggs();
+void updateMissIndicators();
+void updateEggs();
+void buildEggGrid();
+void updatePlayer();
+
+// Remember the state at the start of a tick so rendering can interpolate towards the new one
+void saveSimulationState();
+
+// Advance the game simulation by one step of the given length
+void stepSimulation(float dt);
+
+// Clear all match state back to a fresh game. Per-match containers (miss indicators, effects,
+// trail) live in matchArena, which this resets.
+void resetSimulation();
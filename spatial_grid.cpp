@@ -0,0 +1,72 @@
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+
+void SpatialGrid::configure(float worldSize, float cellSize) {
+    int cells = std::max(1, static_cast<int>(std::ceil(worldSize / cellSize)));
+    if (cells == cellsPerAxis && cellSize == cellExtent && worldSize * 0.5f == halfWorldSize) return;
+
+    cellsPerAxis = cells;
+    cellExtent = cellSize;
+    inverseCellExtent = 1.0f / cellSize;
+    halfWorldSize = worldSize * 0.5f;
+    cellStart.assign(static_cast<size_t>(cells) * cells + 1, 0);
+}
+
+int SpatialGrid::cellIndex(float value) const {
+    int cell = static_cast<int>(std::floor((value + halfWorldSize) * inverseCellExtent));
+    return std::min(std::max(cell, 0), cellsPerAxis - 1);
+}
+
+void SpatialGrid::build(const float* x, const float* z, size_t count) {
+    std::fill(cellStart.begin(), cellStart.end(), 0u);
+    pointCell.resize(count);
+    entryId.resize(count);
+    entryX.resize(count);
+    entryZ.resize(count);
+
+    // Count points per cell and turn the counts into cell end offsets
+    for (size_t i = 0; i < count; i++) {
+        uint32_t cell = static_cast<uint32_t>(cellIndex(z[i]) * cellsPerAxis + cellIndex(x[i]));
+        pointCell[i] = cell;
+        cellStart[cell]++;
+    }
+
+    const size_t cellCount = cellStart.size() - 1;
+    for (size_t c = 1; c < cellCount; c++) {
+        cellStart[c] += cellStart[c - 1];
+    }
+    cellStart[cellCount] = static_cast<uint32_t>(count);
+
+    // Scatter back to front, moving each end offset down to the start of its cell.
+    // Going in reverse keeps points in input order within a cell.
+    for (size_t i = count; i-- > 0; ) {
+        uint32_t slot = --cellStart[pointCell[i]];
+        entryId[slot] = static_cast<uint32_t>(i);
+        entryX[slot] = x[i];
+        entryZ[slot] = z[i];
+    }
+}
+
+void SpatialGrid::queryRadius(float x, float z, float radius, std::vector<uint32_t>& out) const {
+    if (entryId.empty()) return;
+
+    const int minX = cellIndex(x - radius);
+    const int maxX = cellIndex(x + radius);
+    const int minZ = cellIndex(z - radius);
+    const int maxZ = cellIndex(z + radius);
+    const float radiusSquared = radius * radius;
+
+    for (int cz = minZ; cz <= maxZ; cz++) {
+        // Cells of one row are contiguous, so the whole row span is one range
+        const uint32_t begin = cellStart[cz * cellsPerAxis + minX];
+        const uint32_t end = cellStart[cz * cellsPerAxis + maxX + 1];
+        for (uint32_t e = begin; e < end; e++) {
+            float dx = entryX[e] - x;
+            float dz = entryZ[e] - z;
+            if (dx * dx + dz * dz <= radiusSquared) {
+                out.push_back(entryId[e]);
+            }
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+// Uniform grid over the arena's horizontal plane, used as a collision broadphase.
+// Points are bucketed by cell with a counting sort, so a rebuild is linear in the point count
+// and a radius query only touches the cells the circle overlaps.
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+struct SpatialGrid {
+    // Cover a square of the given size centred on the origin; points outside are clamped to the
+    // border cells. Reallocates only when the layout actually changes.
+    void configure(float worldSize, float cellSize);
+
+    // Rebucket count points given as separate x and z arrays. Stored ids are the array indices.
+    void build(const float* x, const float* z, size_t count);
+
+    // Append the ids of all points within radius of (x, z) on the horizontal plane
+    void queryRadius(float x, float z, float radius, std::vector<uint32_t>& out) const;
+
+    size_t size() const { return entryId.size(); }
+    int cellsPerSide() const { return cellsPerAxis; }
+    float cellSize() const { return cellExtent; }
+
+private:
+    int cellIndex(float value) const;
+
+    int cellsPerAxis = 0;
+    float cellExtent = 1.0f;
+    float inverseCellExtent = 1.0f;
+    float halfWorldSize = 0.0f;
+
+    // cellStart[c]..cellStart[c + 1] is the range of cell c in the entry arrays
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> entryId;
+    std::vector<float> entryX; // Positions copied in cell order so queries stay in one cache stream
+    std::vector<float> entryZ;
+    std::vector<uint32_t> pointCell; // Scratch: cell of each input point
+};
@@ -0,0 +1,87 @@
+#include "static_geometry.h"
+#include "gl_state.h"
+#include <algorithm>
+#include <cassert>
+
+static void copyIndices(const std::vector<unsigned int>& indices, uint16_t* destination) {
+    for (size_t i = 0; i < indices.size(); i++) {
+        assert(indices[i] <= 0xFFFF);
+        destination[i] = static_cast<uint16_t>(indices[i]);
+    }
+}
+
+MeshRange StaticGeometry::add(const std::vector<float>& vertices, const std::vector<unsigned int>& indices,
+    size_t maxVertices, size_t maxIndices) {
+    MeshRange mesh;
+    mesh.baseVertex = static_cast<GLint>(vertexCount);
+    mesh.indexOffset = indexCount * sizeof(uint16_t);
+    mesh.indexCount = static_cast<GLsizei>(indices.size());
+    mesh.vertexCapacity = std::max(vertices.size() / FLOATS_PER_VERTEX, maxVertices);
+    mesh.indexCapacity = std::max(indices.size(), maxIndices);
+    assert(mesh.vertexCapacity <= 0x10000);
+
+    vertexData.insert(vertexData.end(), vertices.begin(), vertices.end());
+    vertexData.resize((vertexCount + mesh.vertexCapacity) * FLOATS_PER_VERTEX, 0.0f);
+    indexData.resize(indexCount + mesh.indexCapacity, 0);
+    copyIndices(indices, indexData.data() + indexCount);
+
+    vertexCount += mesh.vertexCapacity;
+    indexCount += mesh.indexCapacity;
+    return mesh;
+}
+
+void StaticGeometry::upload() {
+    glGenBuffers(1, &vertexBuffer);
+    glGenBuffers(1, &indexBuffer);
+
+    glState.bindArrayBuffer(vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_STATIC_DRAW);
+
+    // The copy target leaves the bound VAO's element buffer alone
+    glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, indexData.size() * sizeof(uint16_t), indexData.data(), GL_STATIC_DRAW);
+
+    std::vector<float>().swap(vertexData);
+    std::vector<uint16_t>().swap(indexData);
+}
+
+bool StaticGeometry::replace(MeshRange& mesh, const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
+    if (vertices.size() / FLOATS_PER_VERTEX > mesh.vertexCapacity || indices.size() > mesh.indexCapacity) return false;
+
+    std::vector<uint16_t> shortIndices(indices.size());
+    copyIndices(indices, shortIndices.data());
+
+    glState.bindArrayBuffer(vertexBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, mesh.baseVertex * FLOATS_PER_VERTEX * sizeof(float),
+        vertices.size() * sizeof(float), vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, mesh.indexOffset, shortIndices.size() * sizeof(uint16_t), shortIndices.data());
+
+    mesh.indexCount = static_cast<GLsizei>(indices.size());
+    return true;
+}
+
+void StaticGeometry::attach() const {
+    glState.bindArrayBuffer(vertexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+}
+
+void StaticGeometry::destroy() {
+    glDeleteBuffers(1, &vertexBuffer);
+    glDeleteBuffers(1, &indexBuffer);
+    vertexBuffer = 0;
+    indexBuffer = 0;
+}
+
+void StaticGeometry::draw(const MeshRange& mesh, GLenum mode) const {
+    glDrawElementsBaseVertex(mode, mesh.indexCount, GL_UNSIGNED_SHORT, (void*)mesh.indexOffset, mesh.baseVertex);
+}
+
+void StaticGeometry::drawInstanced(const MeshRange& mesh, GLsizei instanceCount, GLenum mode) const {
+    glDrawElementsInstancedBaseVertex(mode, mesh.indexCount, GL_UNSIGNED_SHORT, (void*)mesh.indexOffset,
+        instanceCount, mesh.baseVertex);
+}
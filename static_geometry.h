@@ -0,0 +1,51 @@
+#pragma once
+// Packed static geometry for every mesh with the position + normal vertex format.
+// All meshes share one vertex buffer and one 16-bit index buffer, and each mesh is a range
+// drawn with a base vertex, so any VAO with the buffers attached can draw any of them.
+// Meshes are collected on the CPU and uploaded together. A mesh that changes at run time (the
+// ground) reserves room for its largest size up front and is rewritten in place.
+#include <glad/glad.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Where one mesh lives inside StaticGeometry
+struct MeshRange {
+    GLint baseVertex = 0;
+    size_t indexOffset = 0; // In bytes
+    GLsizei indexCount = 0;
+    size_t vertexCapacity = 0;
+    size_t indexCapacity = 0;
+};
+
+class StaticGeometry {
+public:
+    static const int FLOATS_PER_VERTEX = 6; // Position, normal
+
+    // Append a mesh before upload(), reserving room for up to maxVertices and maxIndices if larger.
+    // Indices are relative to the mesh's own vertices and must fit in 16 bits.
+    MeshRange add(const std::vector<float>& vertices, const std::vector<unsigned int>& indices,
+        size_t maxVertices = 0, size_t maxIndices = 0);
+
+    // Create the GL buffers from everything added and drop the CPU copies
+    void upload();
+
+    // Rewrite a mesh after upload(); false (and nothing changed) when it doesn't fit its room
+    bool replace(MeshRange& mesh, const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+
+    // Attach the shared buffers to the bound VAO as attributes 0 (position) and 1 (normal)
+    void attach() const;
+    void destroy();
+
+    // Draw with whichever VAO is bound; it must have the buffers attached
+    void draw(const MeshRange& mesh, GLenum mode = GL_TRIANGLES) const;
+    void drawInstanced(const MeshRange& mesh, GLsizei instanceCount, GLenum mode = GL_TRIANGLES) const;
+
+private:
+    std::vector<float> vertexData;
+    std::vector<uint16_t> indexData;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+};
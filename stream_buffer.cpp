@@ -0,0 +1,100 @@
+#include "stream_buffer.h"
+#include "gl_state.h"
+#include <algorithm>
+#include <cstring>
+
+void StreamBuffer::create(size_t capacity) {
+    glGenBuffers(1, &buffer);
+    reallocate(capacity);
+}
+
+void StreamBuffer::destroy() {
+    for (int i = 0; i < regionCount; i++) {
+        glDeleteSync(regions[(firstRegion + i) % MAX_REGIONS].fence);
+    }
+    regionCount = 0;
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+    ringSize = 0;
+}
+
+size_t StreamBuffer::write(const void* data, size_t size, size_t alignment) {
+    // Round up within the current lap, or start the next lap if the data doesn't fit before the end
+    const uint64_t lapStart = head - head % ringSize;
+    const uint64_t offset = (head - lapStart + alignment - 1) / alignment * alignment;
+    uint64_t position = offset + size <= ringSize ? lapStart + offset : lapStart + ringSize;
+
+    // Going round onto this frame's own data would need a fence mid-frame; grow instead
+    if (position + size > frameBegin + ringSize) {
+        reallocate(std::max(ringSize * 2, static_cast<size_t>(position + size - frameBegin) * 2));
+        position = 0;
+    }
+
+    // Wait for any earlier frame still using the bytes being overwritten
+    while (regionCount > 0 && regions[firstRegion].begin + ringSize < position + size) {
+        waitOldest();
+    }
+
+    const size_t ringOffset = static_cast<size_t>(position % ringSize);
+    glState.bindArrayBuffer(buffer);
+    void* target = glMapBufferRange(GL_ARRAY_BUFFER, ringOffset, size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (target) {
+        std::memcpy(target, data, size);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    else {
+        glBufferSubData(GL_ARRAY_BUFFER, ringOffset, size, data);
+    }
+
+    head = position + size;
+    return ringOffset;
+}
+
+void StreamBuffer::reserveFrame(size_t bytes, size_t writeCount) {
+    // Besides the data and its alignment padding, the frame can lose up to one write's size to
+    // the gap left at the end of the ring when a write wraps
+    const size_t room = 2 * bytes + writeCount * (DEFAULT_ALIGNMENT - 1);
+    if (static_cast<size_t>(head - frameBegin) + room <= ringSize) return;
+    reallocate(std::max(ringSize * 2, room * 2));
+}
+
+void StreamBuffer::endFrame() {
+    if (head == frameBegin) return;
+    if (regionCount == MAX_REGIONS) waitOldest();
+
+    Region& region = regions[(firstRegion + regionCount) % MAX_REGIONS];
+    region.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    region.begin = frameBegin;
+    region.end = head;
+    regionCount++;
+    frameBegin = head;
+}
+
+void StreamBuffer::waitOldest() {
+    GLsync fence = regions[firstRegion].fence;
+    if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+        waits++;
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+        }
+    }
+    glDeleteSync(fence);
+    firstRegion = (firstRegion + 1) % MAX_REGIONS;
+    regionCount--;
+}
+
+void StreamBuffer::reallocate(size_t capacity) {
+    // New storage; draws already issued keep reading the old, so no fence needs waiting for.
+    // Offsets handed out this frame now refer to the new storage and are no longer valid.
+    for (int i = 0; i < regionCount; i++) {
+        glDeleteSync(regions[(firstRegion + i) % MAX_REGIONS].fence);
+    }
+    firstRegion = 0;
+    regionCount = 0;
+    head = 0;
+    frameBegin = 0;
+
+    ringSize = capacity;
+    glState.bindArrayBuffer(buffer);
+    glBufferData(GL_ARRAY_BUFFER, ringSize, nullptr, GL_STREAM_DRAW);
+}
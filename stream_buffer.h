@@ -0,0 +1,64 @@
+#pragma once
+// One vertex buffer that all per-frame vertex and instance data is streamed through.
+// Writes are placed one after another around a ring, and each is copied in with an
+// unsynchronized map, so the driver never waits for draws still reading earlier data.
+// Instead, every frame's span of the ring is fenced at endFrame(), and a write only waits
+// when it catches up with a span the GPU may still be reading (normally one from several
+// frames back, which has long finished). A frame that writes more than the whole ring
+// grows it. The old storage is orphaned, and every offset handed out since the last endFrame()
+// now points into the new, empty storage: draws already issued keep reading the old data, but
+// anything still holding an offset to draw from later does not. Code that records offsets to
+// draw from later reserves its frame's room up front with reserveFrame().
+//
+// GL 3.3 has no persistent mapping, so each write maps only its own range.
+#include <glad/glad.h>
+#include <cstdint>
+#include <cstddef>
+
+class StreamBuffer {
+public:
+    static const size_t DEFAULT_ALIGNMENT = 16;
+
+    void create(size_t capacity);
+    void destroy();
+
+    // Copy size bytes into the ring and return their byte offset in id(). The offset is a
+    // multiple of alignment (any size, e.g. a vertex stride, so offset / stride is a vertex
+    // index). Leaves the buffer bound to GL_ARRAY_BUFFER. May grow the ring, which invalidates
+    // the offsets returned since the last endFrame().
+    size_t write(const void* data, size_t size, size_t alignment = DEFAULT_ALIGNMENT);
+
+    // Grow the ring now, if need be, so that up to writeCount more writes of the default
+    // alignment and bytes in total fit this frame without growing it later. Offsets returned
+    // before the call are invalidated if it grows.
+    void reserveFrame(size_t bytes, size_t writeCount);
+
+    // Fence everything written since the last call; once per frame after its draws
+    void endFrame();
+
+    GLuint id() const { return buffer; }
+    size_t capacity() const { return ringSize; }
+    int waitCount() const { return waits; } // Writes that had to wait for the GPU, ever
+
+private:
+    static const int MAX_REGIONS = 8; // Frames in flight that can be fenced at once
+
+    // A fenced span of the ring, in bytes written since the last reallocation
+    struct Region {
+        GLsync fence;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    void waitOldest();
+    void reallocate(size_t capacity);
+
+    GLuint buffer = 0;
+    size_t ringSize = 0;
+    uint64_t head = 0;       // Where the next write goes, counted from the start of the first lap
+    uint64_t frameBegin = 0; // Start of this frame's unfenced writes
+    Region regions[MAX_REGIONS];
+    int firstRegion = 0;
+    int regionCount = 0;
+    int waits = 0;
+};
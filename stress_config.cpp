@@ -0,0 +1,74 @@
+#include "stress_config.h"
+#include "simulation.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+const float STRESS_MAX_GROUND_SIZE = 20000.0f;
+const int STRESS_MAX_EGGS = 1000000;
+const float STRESS_MIN_SPAWN_INTERVAL = 0.00001f;
+const int STRESS_MAX_COLLECTION_PARTICLES = 4096;
+const int STRESS_MAX_TRAIL_PARTICLES = 1000000;
+
+static const float MIN_GROUND_SIZE = 4.0f;
+
+StressConfig defaultStressConfig() {
+    StressConfig config;
+    config.groundSize = 20.0f;
+    config.maxEggs = 10;
+    config.maxPoisonEggs = 5;
+    config.eggSpawnInterval = 4.0f;
+    config.collectionParticles = 16;
+    config.maxTrailParticles = 50;
+    return config;
+}
+
+StressConfig currentStressConfig() {
+    StressConfig config;
+    config.groundSize = GROUND_SIZE;
+    config.maxEggs = MAX_EGGS;
+    config.maxPoisonEggs = MAX_POISON_EGGS;
+    config.eggSpawnInterval = EGG_SPAWN_INTERVAL;
+    config.collectionParticles = COLLECTION_PARTICLES;
+    config.maxTrailParticles = MAX_TRAIL_PARTICLES;
+    return config;
+}
+
+void applyStressConfig(const StressConfig& config) {
+    GROUND_SIZE = glm::clamp(config.groundSize, MIN_GROUND_SIZE, STRESS_MAX_GROUND_SIZE);
+    WORLD_BOUNDARY = GROUND_SIZE / 2.0f + 1.0f;
+    MAX_EGGS = glm::clamp(config.maxEggs, 0, STRESS_MAX_EGGS);
+    MAX_POISON_EGGS = glm::clamp(config.maxPoisonEggs, 0, STRESS_MAX_EGGS);
+    EGG_SPAWN_INTERVAL = std::max(config.eggSpawnInterval, STRESS_MIN_SPAWN_INTERVAL);
+    COLLECTION_PARTICLES = glm::clamp(config.collectionParticles, 1, STRESS_MAX_COLLECTION_PARTICLES);
+    MAX_TRAIL_PARTICLES = glm::clamp(config.maxTrailParticles, 1, STRESS_MAX_TRAIL_PARTICLES);
+}
+
+bool parseStressOption(int argc, char** argv, int& i, StressConfig& config) {
+    if (i + 1 >= argc) return false;
+
+    const char* option = argv[i];
+    const char* value = argv[i + 1];
+    if (strcmp(option, "--ground-size") == 0) config.groundSize = static_cast<float>(atof(value));
+    else if (strcmp(option, "--max-eggs") == 0) config.maxEggs = atoi(value);
+    else if (strcmp(option, "--max-poison-eggs") == 0) config.maxPoisonEggs = atoi(value);
+    else if (strcmp(option, "--egg-spawn-interval") == 0) config.eggSpawnInterval = static_cast<float>(atof(value));
+    else if (strcmp(option, "--collection-particles") == 0) config.collectionParticles = atoi(value);
+    else if (strcmp(option, "--max-trail-particles") == 0) config.maxTrailParticles = atoi(value);
+    else return false;
+
+    i++;
+    return true;
+}
+
+void printStressOptions() {
+    StressConfig defaults = defaultStressConfig();
+    std::cout << "Stress options:" << std::endl;
+    std::cout << "  --ground-size S           Arena side length (default " << defaults.groundSize << ")" << std::endl;
+    std::cout << "  --max-eggs N              Regular egg limit (default " << defaults.maxEggs << ")" << std::endl;
+    std::cout << "  --max-poison-eggs N       Poison egg limit (default " << defaults.maxPoisonEggs << ")" << std::endl;
+    std::cout << "  --egg-spawn-interval S    Seconds between regular eggs (default " << defaults.eggSpawnInterval << ")" << std::endl;
+    std::cout << "  --collection-particles N  Particles per collection burst (default " << defaults.collectionParticles << ")" << std::endl;
+    std::cout << "  --max-trail-particles N   Trail particle limit (default " << defaults.maxTrailParticles << ")" << std::endl;
+}
@@ -0,0 +1,33 @@
+#pragma once
+// Arena size and population limits, adjustable at runtime for stress runs.
+// The limits themselves are the simulation globals (GROUND_SIZE, MAX_EGGS, ...); this groups
+// them so the command line and the F1 panel can read and change them together.
+// Limits are sized into the match containers on reset, so apply a config between matches
+// (followed by resetSimulation) rather than in the middle of one.
+
+struct StressConfig {
+    float groundSize;
+    int maxEggs;
+    int maxPoisonEggs;
+    float eggSpawnInterval;
+    int collectionParticles;
+    int maxTrailParticles;
+};
+
+// Supported ranges
+extern const float STRESS_MAX_GROUND_SIZE;
+extern const int STRESS_MAX_EGGS;
+extern const float STRESS_MIN_SPAWN_INTERVAL;
+extern const int STRESS_MAX_COLLECTION_PARTICLES;
+extern const int STRESS_MAX_TRAIL_PARTICLES;
+
+StressConfig defaultStressConfig(); // The normal game
+StressConfig currentStressConfig();
+
+// Clamp every value to its supported range and write it into the simulation
+void applyStressConfig(const StressConfig& config);
+
+// If argv[i] is a stress option, parse it (and its value) into config, advance i past it and
+// return true
+bool parseStressOption(int argc, char** argv, int& i, StressConfig& config);
+void printStressOptions();